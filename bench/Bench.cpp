@@ -0,0 +1,1013 @@
+/*
+ Raster-Font benchmark
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "BitTranspose.h"
+#include "CodePage.h"
+#include "CompressedFonts.h"
+#include "FontManager.h"
+#include "FontPack.h"
+#include "Instrument.h"
+#include "TextLayout.h"
+
+/*
+ * Usage: Raster-Font-bench [--format csv|json] [--output file] [--min-ms n]
+ *                          [--font n] [--op name] [--corpus name] [--compression | --verify]
+ *
+ * Times each operation over each corpus for every font, both rasters and, for
+ * rasterizing, every position offset. Glyphs are the characters processed; bytes
+ * are the bitmap bytes produced by the rasterize operations and the text bytes
+ * consumed by the measuring and wrapping operations. The wrapping operations lay
+ * out about a megabyte of the corpus at a time. The _utf8 operations take the
+ * corpus as UTF-8, mapped back to the font's code page. The scaled operations
+ * rasterize at 2x, 3x and 4x, by the font manager's scale and by naively scaling
+ * the unscaled bitmap a pixel at a time afterwards, as applications did. The
+ * turned operations rasterize in the right, bottom and left orientations, by the
+ * font manager and by turning the top oriented bitmap a pixel at a time. The
+ * layout operations rasterize to the LSB first, MSB top, bottom up and color
+ * rasters, by the font manager and by converting the LRTB or PTBLR bitmap a pixel
+ * at a time.
+ *
+ * --compression instead reports, for each font, the bitmap bytes against the
+ * compressed glyph and offset bytes, and the throughput of decoding every glyph.
+ *
+ * --verify instead checks every transpose kernel the CPU supports against the
+ * scalar kernel, exiting non-zero on any difference.
+ */
+
+#define BENCH_VERSION "0.1.0"      ///< Output format version
+#define BREAK_WIDTH 128            ///< Pixel width for CharacterBreaks, an SSD1306 line
+#define WRAP_BYTES (1 << 20)       ///< Size of the text word wrapped in one pass
+
+/**
+ * @brief A named set of lines to process
+ */
+struct Corpus
+{
+    const char *name;
+    CodePage page;                  ///< Encoding of the lines
+    std::vector<std::string> lines;
+    std::vector<std::string> utf8;  ///< The lines in UTF-8
+};
+
+/**
+ * @brief Work done in one pass over a corpus
+ */
+struct Work
+{
+    uint64_t glyphs;
+    uint64_t bytes;
+};
+
+/**
+ * @brief One timed measurement
+ */
+struct Result
+{
+    uint8_t font;
+    const char *raster; ///< Raster, or "any" when the operation does not depend on it
+    int offset;         ///< Position offset, or -1 when the operation does not take one
+    const char *corpus;
+    const char *op;
+    uint64_t passes;
+    uint64_t glyphs;
+    uint64_t bytes;
+    uint64_t ns;
+};
+
+static volatile uint64_t sink; ///< Keeps results live
+
+static const char *SCALED_OPS[][2] = {{"rasterize_scaled_2x", "post_scale_2x"},
+                                      {"rasterize_scaled_3x", "post_scale_3x"},
+                                      {"rasterize_scaled_4x", "post_scale_4x"}}; ///< Scaled and post-scaled operations of each scale from 2
+static const char *TURNED_OPS[][2] = {{"rasterize_right", "post_turn_right"},
+                                      {"rasterize_bottom", "post_turn_bottom"},
+                                      {"rasterize_left", "post_turn_left"}}; ///< Turned and post-turned operations of each orientation from R
+static const char *RASTER_NAMES[] = {"LRTB", "PTBLR", "LRTB_LSB", "PTBLR_MSB", "PBTLR", "RGB565", "RGB888", "INDEXED8", "GRAY2", "GRAY4"}; ///< Name of each raster
+static const struct
+{
+    FontManager::Raster base;   ///< The raster converted from
+    FontManager::Raster raster; ///< The raster converted to
+    const char *ops[2];         ///< Rasterized and post-converted operations
+} LAYOUT_OPS[] = {{FontManager::LRTB, FontManager::LRTB_LSB, {"rasterize_lsb_first", "post_lsb_first"}},
+                  {FontManager::PTBLR, FontManager::PTBLR_MSB, {"rasterize_msb_top", "post_msb_top"}},
+                  {FontManager::PTBLR, FontManager::PBTLR, {"rasterize_bottom_up", "post_bottom_up"}},
+                  {FontManager::LRTB, FontManager::RGB565, {"rasterize_rgb565", "post_rgb565"}},
+                  {FontManager::LRTB, FontManager::RGB888, {"rasterize_rgb888", "post_rgb888"}},
+                  {FontManager::LRTB, FontManager::INDEXED8, {"rasterize_indexed8", "post_indexed8"}}}; ///< Layout operations of each raster beyond LRTB and PTBLR
+static const struct
+{
+    FontManager::Raster raster; ///< The gray raster
+    const char *ops[3];         ///< Cached and uncached downsampled, and post-filtered operations
+} GRAY_OPS[] = {{FontManager::GRAY2, {"rasterize_gray2_2x", "rasterize_gray2_2x_uncached", "post_gray2_2x"}},
+                {FontManager::GRAY4, {"rasterize_gray4_2x", "rasterize_gray4_2x_uncached", "post_gray4_2x"}}}; ///< Downsampled operations of each gray raster
+
+/**
+ * @brief Dashboard style ASCII lines
+ */
+static Corpus asciiCorpus()
+{
+    Corpus corpus{"ascii-dashboard", CODEPAGE_ASCII, {}, {}};
+    char line[64];
+
+    for (int i = 0; i < 16; i++)
+    {
+        snprintf(line, sizeof(line), "CPU %2d%% MEM %d.%dG", (i * 37) % 100, i % 8, (i * 3) % 10);
+        corpus.lines.push_back(line);
+        snprintf(line, sizeof(line), "NET %4dkB/s T %2d.%dC", (i * 113) % 2048, 20 + i, i % 10);
+        corpus.lines.push_back(line);
+        snprintf(line, sizeof(line), "12:%02d:%02d UP %dd %02dh", i * 3, (i * 7) % 60, i, (i * 5) % 24);
+        corpus.lines.push_back(line);
+    }
+    return corpus;
+} // asciiCorpus
+
+/**
+ * @brief Western European text, ISO-8859-1 encoded
+ */
+static Corpus latin1Corpus()
+{
+    return {"iso-8859-1", CODEPAGE_ISO8859_1,
+            {
+                "Zw\xf6lf Boxk\xe4mpfer jagen Viktor quer \xfc" "ber den gro\xdf" "en Sylter Deich.",
+                "Voix ambigu\xeb d'un coeur qui, au z\xe9phyr, pr\xe9" "f\xe8re les jattes de kiwis.",
+                "El ping\xfcino Wenceslao hizo kil\xf3metros bajo exhaustiva lluvia y fr\xedo.",
+                "H\xf8j b\xf8lge p\xe5 \xc6r\xf8: 23,5\xb0" "C, \xb1" "0,2 \xb5m, \xbd \xa9 2019.",
+            },
+            {}};
+} // latin1Corpus
+
+/**
+ * @brief Russian text, KOI8-R encoded
+ */
+static Corpus koi8Corpus()
+{
+    return {"koi8-r", CODEPAGE_KOI8_R,
+            {
+                "\xf3\xdf\xc5\xdb\xd8 \xd6\xc5 \xc5\xdd\xa3 \xdc\xd4\xc9\xc8 \xcd\xd1\xc7\xcb\xc9\xc8 \xc6\xd2\xc1\xce\xc3\xd5\xda\xd3\xcb\xc9\xc8 \xc2\xd5\xcc\xcf\xcb, \xc4\xc1 \xd7\xd9\xd0\xc5\xca \xd6\xc5 \xde\xc1\xc0.",
+                "\xfb\xc9\xd2\xcf\xcb\xc1\xd1 \xdc\xcc\xc5\xcb\xd4\xd2\xc9\xc6\xc9\xcb\xc1\xc3\xc9\xd1 \xc0\xd6\xce\xd9\xc8 \xc7\xd5\xc2\xc5\xd2\xce\xc9\xca \xc4\xc1\xd3\xd4 \xcd\xcf\xdd\xce\xd9\xca \xd4\xcf\xcc\xde\xcf\xcb \xd0\xcf\xc4\xdf\xa3\xcd\xd5 \xd3\xc5\xcc\xd8\xd3\xcb\xcf\xc7\xcf \xc8\xcf\xda\xd1\xca\xd3\xd4\xd7\xc1.",
+                "\xf7 \xde\xc1\xdd\xc1\xc8 \xc0\xc7\xc1 \xd6\xc9\xcc \xc2\xd9 \xc3\xc9\xd4\xd2\xd5\xd3? \xe4\xc1, \xce\xcf \xc6\xc1\xcc\xd8\xdb\xc9\xd7\xd9\xca \xdc\xcb\xda\xc5\xcd\xd0\xcc\xd1\xd2!",
+                "\xf4\xc5\xcd\xd0\xc5\xd2\xc1\xd4\xd5\xd2\xc1 23,5\x9c" "C, \xc4\xc1\xd7\xcc\xc5\xce\xc9\xc5 755 \xcd\xcd \xd2\xd4. \xd3\xd4., \xd7\xcc\xc1\xd6\xce\xcf\xd3\xd4\xd8 64%.",
+            },
+            {}};
+} // koi8Corpus
+
+/**
+ * @brief Repeats passes of an operation over a corpus for at least the minimum time
+ *
+ * @param pass one pass, returning the work done
+ * @param min_ms the minimum time to run
+ * @param result filled with the passes, work and time
+ */
+template <typename Pass>
+static void timePasses(Pass pass, unsigned min_ms, Result &result)
+{
+    auto start = std::chrono::steady_clock::now();
+    uint64_t min_ns = (uint64_t)min_ms * 1000000;
+
+    result.passes = result.glyphs = result.bytes = result.ns = 0;
+    do
+    {
+        Work work = pass();
+        result.passes++;
+        result.glyphs += work.glyphs;
+        result.bytes += work.bytes;
+        result.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    } while (result.ns < min_ns);
+} // timePasses
+
+/**
+ * @brief Scales a bitmap by whole pixels a pixel at a time, the naive way after Rasterize
+ *
+ * @param bm the unscaled bitmap, without position offset
+ * @param scale the times to repeat each pixel across and down
+ * @param scaled the scaled bitmap, in the same raster
+ * @return the bytes of the scaled bitmap
+ */
+static size_t postScale(const FontManager::Bitmap &bm, uint8_t scale, std::vector<uint8_t> &scaled)
+{
+    bool lrtb = bm.raster == FontManager::LRTB;
+    uint16_t width = bm.width_pixels * scale, height = bm.height_pixels * scale;
+    size_t stride = lrtb ? ((width + 7) / 8) : width;
+    scaled.assign(lrtb ? stride * height : stride * ((height + 7) / 8), 0);
+
+    for (uint16_t y = 0; y < height; y++)
+    {
+        for (uint16_t x = 0; x < width; x++)
+        {
+            uint16_t sx = x / scale, sy = y / scale;
+            bool set = lrtb ? (bm.data[(sy * bm.stride) + (sx / 8)] & (0x80 >> (sx % 8)))
+                            : (bm.data[((sy / 8) * bm.stride) + sx] & (1 << (sy % 8)));
+            if (set && lrtb)
+                scaled[(y * stride) + (x / 8)] |= 0x80 >> (x % 8);
+            else if (set)
+                scaled[((y / 8) * stride) + x] |= 1 << (y % 8);
+        }
+    }
+    return scaled.size();
+} // postScale
+
+/**
+ * @brief Turns a bitmap clockwise by quarter turns a pixel at a time, the naive way after Rasterize
+ *
+ * @param bm the top oriented bitmap, without position offset
+ * @param turns the quarter turns clockwise, 1 to 3
+ * @param turned the turned bitmap, in the same raster
+ * @return the bytes of the turned bitmap
+ */
+static size_t postTurn(const FontManager::Bitmap &bm, uint8_t turns, std::vector<uint8_t> &turned)
+{
+    bool lrtb = bm.raster == FontManager::LRTB;
+    uint16_t width = (turns & 1) ? bm.height_pixels : bm.width_pixels;
+    uint16_t height = (turns & 1) ? bm.width_pixels : bm.height_pixels;
+    size_t stride = lrtb ? ((width + 7) / 8) : width;
+    turned.assign(lrtb ? stride * height : stride * ((height + 7) / 8), 0);
+
+    for (uint16_t y = 0; y < height; y++)
+    {
+        for (uint16_t x = 0; x < width; x++)
+        {
+            uint16_t sx = x, sy = y;
+            if (turns == 1)
+                sx = y, sy = bm.height_pixels - 1 - x;
+            else if (turns == 2)
+                sx = bm.width_pixels - 1 - x, sy = bm.height_pixels - 1 - y;
+            else
+                sx = bm.width_pixels - 1 - y, sy = x;
+            bool set = lrtb ? (bm.data[(sy * bm.stride) + (sx / 8)] & (0x80 >> (sx % 8)))
+                            : (bm.data[((sy / 8) * bm.stride) + sx] & (1 << (sy % 8)));
+            if (set && lrtb)
+                turned[(y * stride) + (x / 8)] |= 0x80 >> (x % 8);
+            else if (set)
+                turned[((y / 8) * stride) + x] |= 1 << (y % 8);
+        }
+    }
+    return turned.size();
+} // postTurn
+
+/**
+ * @brief Converts a bitmap to another raster a pixel at a time, the naive way after Rasterize
+ *
+ * @param bm the LRTB or PTBLR bitmap, without position offset
+ * @param raster the raster to convert to, LRTB_LSB or a color raster, white on black, from
+ *               LRTB or PTBLR_MSB or PBTLR from PTBLR
+ * @param converted the bitmap in the raster
+ * @return the bytes of the converted bitmap
+ */
+static size_t postLayout(const FontManager::Bitmap &bm, FontManager::Raster raster, std::vector<uint8_t> &converted)
+{
+    bool lrtb = bm.raster == FontManager::LRTB;
+    uint8_t pixel_bytes = FontManager::PixelBytes(raster);
+    size_t stride = pixel_bytes ? bm.width_pixels * pixel_bytes : lrtb ? ((bm.width_pixels + 7) / 8) : bm.width_pixels;
+    uint16_t pages = (bm.height_pixels + 7) / 8;
+    converted.assign(lrtb ? stride * bm.height_pixels : stride * pages, 0);
+
+    for (uint16_t y = 0; y < bm.height_pixels; y++)
+    {
+        for (uint16_t x = 0; x < bm.width_pixels; x++)
+        {
+            bool set = lrtb ? (bm.data[(y * bm.stride) + (x / 8)] & (0x80 >> (x % 8)))
+                            : (bm.data[((y / 8) * bm.stride) + x] & (1 << (y % 8)));
+            uint16_t up = bm.height_pixels - 1 - y;
+            if (pixel_bytes)
+                memset(&converted[(y * stride) + (x * pixel_bytes)], set ? 0xFF : 0, pixel_bytes);
+            else if (set && lrtb)
+                converted[(y * stride) + (x / 8)] |= 1 << (x % 8);
+            else if (set && raster == FontManager::PTBLR_MSB)
+                converted[((y / 8) * stride) + x] |= 0x80 >> (y % 8);
+            else if (set)
+                converted[((up / 8) * stride) + x] |= 1 << (up % 8);
+        }
+    }
+    return converted.size();
+} // postLayout
+
+/**
+ * @brief Box filters a bitmap down into gray pixels a pixel at a time, the naive way after Rasterize
+ *
+ * The boxes are aligned to the bitmap rather than to each character.
+ *
+ * @param bm the LRTB bitmap, without position offset
+ * @param raster the gray raster to filter into
+ * @param factor the bitmap pixels across and down each gray pixel
+ * @param gray the gray bitmap
+ * @return the bytes of the gray bitmap
+ */
+static size_t postShrink(const FontManager::Bitmap &bm, FontManager::Raster raster, uint8_t factor, std::vector<uint8_t> &gray)
+{
+    uint8_t bits = FontManager::GrayBits(raster);
+    uint8_t levels = (1 << bits) - 1;
+    uint16_t area = factor * factor;
+    uint16_t width = (bm.width_pixels + factor - 1) / factor, height = (bm.height_pixels + factor - 1) / factor;
+    size_t stride = ((width * bits) + 7) / 8;
+    gray.assign(stride * height, 0);
+
+    for (uint16_t y = 0; y < height; y++)
+    {
+        for (uint16_t x = 0; x < width; x++)
+        {
+            uint16_t count = 0;
+            for (uint16_t sy = y * factor; sy < std::min<uint16_t>((y + 1) * factor, bm.height_pixels); sy++)
+            {
+                for (uint16_t sx = x * factor; sx < std::min<uint16_t>((x + 1) * factor, bm.width_pixels); sx++)
+                {
+                    count += (bm.data[(sy * bm.stride) + (sx / 8)] >> (7 - (sx % 8))) & 1;
+                }
+            }
+            uint8_t level = ((count * levels) + (area / 2)) / area;
+            gray[(y * stride) + ((x * bits) / 8)] |= level << (8 - bits - ((x * bits) % 8));
+        }
+    }
+    return gray.size();
+} // postShrink
+
+/**
+ * @brief Writes the results as CSV
+ */
+static void writeCSV(FILE *out, const std::vector<Result> &results)
+{
+    fprintf(out, "font,font_name,raster,offset,corpus,op,passes,glyphs,bytes,ns,glyphs_per_sec,bytes_per_sec\n");
+    for (const Result &r : results)
+    {
+        double seconds = r.ns / 1e9;
+        fprintf(out, "%u,%s,%s,%d,%s,%s,%llu,%llu,%llu,%llu,%.0f,%.0f\n", r.font, FontManager::FontList()[r.font], r.raster, r.offset, r.corpus, r.op,
+                (unsigned long long)r.passes, (unsigned long long)r.glyphs, (unsigned long long)r.bytes, (unsigned long long)r.ns,
+                r.glyphs / seconds, r.bytes / seconds);
+    }
+} // writeCSV
+
+/**
+ * @brief Writes the results as JSON
+ */
+static void writeJSON(FILE *out, const std::vector<Result> &results)
+{
+    fprintf(out, "{\n  \"benchmark\": \"Raster-Font\",\n  \"version\": \"%s\",\n", BENCH_VERSION);
+    fprintf(out, "  \"transpose_kernel\": \"%s\",\n", TransposeKernelName(ActiveTransposeKernel()));
+    fprintf(out, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Result &r = results[i];
+        double seconds = r.ns / 1e9;
+        fprintf(out,
+                "    {\"font\": %u, \"font_name\": \"%s\", \"raster\": \"%s\", \"offset\": %d, \"corpus\": \"%s\", \"op\": \"%s\", "
+                "\"passes\": %llu, \"glyphs\": %llu, \"bytes\": %llu, \"ns\": %llu, \"glyphs_per_sec\": %.0f, \"bytes_per_sec\": %.0f}%s\n",
+                r.font, FontManager::FontList()[r.font], r.raster, r.offset, r.corpus, r.op, (unsigned long long)r.passes,
+                (unsigned long long)r.glyphs, (unsigned long long)r.bytes, (unsigned long long)r.ns, r.glyphs / seconds, r.bytes / seconds,
+                (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+} // writeJSON
+
+/**
+ * @brief The compression of one font
+ */
+struct Compression
+{
+    uint8_t font;
+    bool baked;              ///< Baked compressed, its bitmap not linked
+    size_t raw_bytes;        ///< Bitmap bytes of the font
+    size_t compressed_bytes; ///< Compressed glyph and offset bytes
+    Result decode;           ///< Decoding every glyph
+};
+
+/**
+ * @brief Compresses a font at run time, unless baked compressed, and times decoding every glyph
+ */
+static Compression compressionOf(uint8_t font, unsigned min_ms)
+{
+    const font_info_t *info = fonts[font];
+    size_t count = info->char_end - info->char_start + 1;
+    Compression compression{font, compressed_fonts[font] != nullptr, 0, 0, {font, "any", -1, "glyphs", "decode_glyph", 0, 0, 0, 0}};
+
+    std::vector<uint8_t> glyphs;
+    std::vector<uint16_t> offsets;
+    compressed_font_info_t compressed;
+    if (compression.baked)
+    {
+        compressed = *compressed_fonts[font];
+    }
+    else
+    {
+        glyphs.resize(CompressFont(info, nullptr, nullptr));
+        offsets.resize(count);
+        CompressFont(info, glyphs.data(), offsets.data());
+        compressed = {glyphs.data(), offsets.data(), (uint32_t)glyphs.size()};
+    }
+
+    compression.raw_bytes = FontPack::BitmapBytes(info);
+    compression.compressed_bytes = compressed.size + (count * sizeof(uint16_t));
+
+    std::vector<uint8_t> rows(info->height * 32);
+    timePasses([&] {
+        Work work{0, 0};
+        for (size_t c = 0; c < count; c++)
+        {
+            DecodeGlyph(&compressed, info, c, rows.data());
+            sink = sink + rows[0];
+            work.glyphs++;
+            work.bytes += info->height * (1 + ((info->char_descriptors[c].width - 1) / 8));
+        }
+        return work;
+    }, min_ms, compression.decode);
+    return compression;
+} // compressionOf
+
+/**
+ * @brief Writes the compression of each font as CSV or JSON
+ *
+ * The flash saved by baking a font compressed is its bitmap, no longer linked,
+ * less the compressed glyphs and offsets; negative where compressing costs flash.
+ * JSON totals it over the baked fonts.
+ */
+static void writeCompression(FILE *out, const std::vector<Compression> &compressions, bool json)
+{
+    if (json)
+        fprintf(out, "{\n  \"benchmark\": \"Raster-Font compression\",\n  \"version\": \"%s\",\n  \"fonts\": [\n", BENCH_VERSION);
+    else
+        fprintf(out, "font,font_name,baked,raw_bytes,compressed_bytes,saved_bytes,ratio,glyphs,ns,glyphs_per_sec,bytes_per_sec\n");
+
+    long long saved_total = 0;
+    for (size_t i = 0; i < compressions.size(); i++)
+    {
+        const Compression &c = compressions[i];
+        double seconds = c.decode.ns / 1e9;
+        double ratio = (double)c.raw_bytes / c.compressed_bytes;
+        long long saved = (long long)c.raw_bytes - (long long)c.compressed_bytes;
+        if (c.baked)
+            saved_total += saved;
+        if (json)
+            fprintf(out, "    {\"font\": %u, \"font_name\": \"%s\", \"baked\": %s, \"raw_bytes\": %zu, \"compressed_bytes\": %zu, "
+                    "\"saved_bytes\": %lld, \"ratio\": %.3f, \"glyphs\": %llu, \"ns\": %llu, \"glyphs_per_sec\": %.0f, \"bytes_per_sec\": %.0f}%s\n",
+                    c.font, FontManager::FontList()[c.font], c.baked ? "true" : "false", c.raw_bytes, c.compressed_bytes, saved, ratio,
+                    (unsigned long long)c.decode.glyphs, (unsigned long long)c.decode.ns, c.decode.glyphs / seconds, c.decode.bytes / seconds,
+                    (i + 1 < compressions.size()) ? "," : "");
+        else
+            fprintf(out, "%u,%s,%d,%zu,%zu,%lld,%.3f,%llu,%llu,%.0f,%.0f\n", c.font, FontManager::FontList()[c.font], c.baked, c.raw_bytes,
+                    c.compressed_bytes, saved, ratio, (unsigned long long)c.decode.glyphs, (unsigned long long)c.decode.ns,
+                    c.decode.glyphs / seconds, c.decode.bytes / seconds);
+    }
+
+    if (json)
+        fprintf(out, "  ],\n  \"saved_bytes\": %lld\n}\n", saved_total); // Of the baked fonts
+} // writeCompression
+
+/**
+ * @brief Are two bitmaps the same
+ */
+static bool sameBitmap(const FontManager::Bitmap &a, const FontManager::Bitmap &b)
+{
+    return a.width_pixels == b.width_pixels && a.height_pixels == b.height_pixels && a.size == b.size &&
+           (!a.size || !memcmp(a.data, b.data, a.size));
+} // sameBitmap
+
+/**
+ * @brief Checks the supported transpose kernels produce the scalar kernel's bitmaps
+ *
+ * Every character of each font is rasterized in every raster, orientation and
+ * position offset, and a sample of characters at each integer scale across,
+ * down and both, and in the gray rasters at each downsample factor. Each kernel
+ * has its own font managers, so glyph caches are filled by the kernel checked.
+ *
+ * @param only_font the font to check, -1 for all
+ * @return the number of bitmaps that differ
+ */
+static unsigned verifyKernels(int only_font)
+{
+    TransposeKernel active = ActiveTransposeKernel();
+    std::vector<TransposeKernel> kernels;
+    for (int k = TRANSPOSE_SCALAR; k < TRANSPOSE_KERNELS; k++)
+    {
+        if (TransposeKernelSupported(static_cast<TransposeKernel>(k)))
+            kernels.push_back(static_cast<TransposeKernel>(k));
+    }
+
+    /*
+     * Scales as across and down, then downsample factors as 0 and the factor
+     */
+    std::vector<std::pair<uint8_t, uint8_t>> scales = {{1, 1}};
+    for (uint8_t scale = 2; scale <= MAX_SCALE; scale++)
+    {
+        scales.insert(scales.end(), {{scale, scale}, {scale, 1}, {1, scale}});
+    }
+    for (uint8_t factor = 2; factor <= MAX_DOWNSAMPLE; factor++)
+    {
+        scales.push_back({0, factor});
+    }
+
+    unsigned mismatches = 0;
+    uint64_t checked = 0;
+    for (uint8_t font = 0; font < FontManager::FontCount(); font++)
+    {
+        if (only_font >= 0 && only_font != font)
+            continue;
+
+        const font_info_t *info = fonts[font];
+        std::string all, sample;
+        for (unsigned int c = info->char_start; c <= info->char_end; c++)
+        {
+            all += static_cast<char>(c);
+            if (!((c - info->char_start) % 37)) // Spread over the range
+                sample += static_cast<char>(c);
+        }
+
+        for (int raster = FontManager::LRTB; raster <= FontManager::GRAY4; raster++)
+        {
+            for (int turns = FontManager::T; turns <= FontManager::L; turns++)
+            {
+                std::vector<FontManager> fms;
+                fms.reserve(kernels.size());
+                for (size_t k = 0; k < kernels.size(); k++)
+                {
+                    fms.emplace_back(font, static_cast<FontManager::Raster>(raster), static_cast<FontManager::Orientation>(turns));
+                    fms.back().Colors(0xA5C3E1, 0x1E3C5A);
+                }
+
+                for (const std::pair<uint8_t, uint8_t> &scale : scales)
+                {
+                    bool downsample = !scale.first;
+                    bool set = true;
+                    for (FontManager &fm : fms)
+                    {
+                        set = set && (downsample ? fm.Downsample(scale.second) : fm.Scale(scale.first, scale.second));
+                    }
+                    if (!set)
+                        continue; // Too wide at the scale, or not a gray raster
+
+                    const std::string &text = (scale.first == 1 && scale.second == 1) ? all : sample;
+                    for (uint16_t offset = 0; offset < 8; offset++)
+                    {
+                        SelectTransposeKernel(TRANSPOSE_SCALAR);
+                        FontManager::Bitmap reference = fms[0].Rasterize(text, offset);
+                        for (size_t k = 1; k < kernels.size(); k++)
+                        {
+                            SelectTransposeKernel(kernels[k]);
+                            checked++;
+                            if (sameBitmap(reference, fms[k].Rasterize(text, offset)))
+                                continue;
+                            if (mismatches++ < 20)
+                                fprintf(stderr, "Mismatch: %s kernel, font %u %s, %s, orientation %d, offset %u, %s %u by %u\n",
+                                        TransposeKernelName(kernels[k]), font, info->name, RASTER_NAMES[raster], turns, offset,
+                                        downsample ? "downsampled" : "scaled", downsample ? scale.second : scale.first, scale.second);
+                        }
+                    }
+
+                    for (FontManager &fm : fms)
+                    {
+                        downsample ? fm.Downsample(1) : fm.Scale(1, 1);
+                    }
+                }
+            }
+        }
+    }
+
+    SelectTransposeKernel(active);
+    for (TransposeKernel kernel : kernels)
+    {
+        printf("%s%s", (kernel == kernels[0]) ? "Kernels " : ", ", TransposeKernelName(kernel));
+    }
+    printf(": %llu bitmaps checked against the scalar kernel, %u mismatches\n", (unsigned long long)checked, mismatches);
+    return mismatches;
+} // verifyKernels
+
+int main(int argc, char *argv[])
+{
+    const char *format = "csv";
+    const char *output = nullptr;
+    const char *only_op = nullptr;
+    const char *only_corpus = nullptr;
+    int only_font = -1;
+    unsigned min_ms = 10;
+    bool compression = false;
+    bool verify = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--compression"))
+        {
+            compression = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "--verify"))
+        {
+            verify = true;
+            continue;
+        }
+
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value)
+        {
+            fprintf(stderr, "Missing value for %s\n", argv[i]);
+            return 1;
+        }
+        else if (!strcmp(argv[i], "--format"))
+            format = value;
+        else if (!strcmp(argv[i], "--output"))
+            output = value;
+        else if (!strcmp(argv[i], "--min-ms"))
+            min_ms = strtoul(value, nullptr, 10);
+        else if (!strcmp(argv[i], "--font"))
+            only_font = atoi(value);
+        else if (!strcmp(argv[i], "--op"))
+            only_op = value;
+        else if (!strcmp(argv[i], "--corpus"))
+            only_corpus = value;
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+        i++;
+    }
+    if (strcmp(format, "csv") && strcmp(format, "json"))
+    {
+        fprintf(stderr, "Unknown format %s, csv or json\n", format);
+        return 1;
+    }
+    if (verify)
+        return verifyKernels(only_font) ? 1 : 0;
+
+    std::vector<Corpus> corpora = {asciiCorpus(), latin1Corpus(), koi8Corpus()};
+    for (Corpus &corpus : corpora)
+    {
+        for (const std::string &line : corpus.lines)
+        {
+            std::string utf8;
+            for (unsigned char c : line)
+            {
+                EncodeUtf8(CodePageChar(corpus.page, c), utf8);
+            }
+            corpus.utf8.push_back(utf8);
+        }
+    }
+    std::vector<Result> results;
+    std::vector<Compression> compressions;
+
+    auto wanted = [](const char *only, const char *name) { return !only || !strcmp(only, name); };
+
+    for (uint8_t font = 0; font < FontManager::FontCount(); font++)
+    {
+        if (only_font >= 0 && only_font != font)
+            continue;
+
+        if (compression)
+        {
+            compressions.push_back(compressionOf(font, min_ms));
+            continue;
+        }
+
+        for (const Corpus &corpus : corpora)
+        {
+            if (!wanted(only_corpus, corpus.name))
+                continue;
+
+            FontManager fm(font, FontManager::LRTB);
+            Result result{font, "any", -1, corpus.name, "", 0, 0, 0, 0};
+
+            if (wanted(only_op, "measure_string"))
+            {
+                result.op = "measure_string";
+                timePasses([&] {
+                    Work work{0, 0};
+                    for (const std::string &line : corpus.lines)
+                    {
+                        sink = sink + fm.MeasureString(line).x_pixels;
+                        work.glyphs += line.size();
+                        work.bytes += line.size();
+                    }
+                    return work;
+                }, min_ms, result);
+                results.push_back(result);
+            }
+
+            if (wanted(only_op, "measure_string_utf8"))
+            {
+                FontManager ufm(font, FontManager::LRTB);
+                ufm.Utf8(true);
+                result.op = "measure_string_utf8";
+                timePasses([&] {
+                    Work work{0, 0};
+                    for (size_t i = 0; i < corpus.utf8.size(); i++)
+                    {
+                        sink = sink + ufm.MeasureString(corpus.utf8[i]).x_pixels;
+                        work.glyphs += corpus.lines[i].size();
+                        work.bytes += corpus.utf8[i].size();
+                    }
+                    return work;
+                }, min_ms, result);
+                results.push_back(result);
+            }
+
+            if (wanted(only_op, "character_breaks"))
+            {
+                result.op = "character_breaks";
+                timePasses([&] {
+                    Work work{0, 0};
+                    for (const std::string &line : corpus.lines)
+                    {
+                        sink = sink + fm.CharacterBreaks(line, BREAK_WIDTH).size();
+                        work.glyphs += line.size();
+                        work.bytes += line.size();
+                    }
+                    return work;
+                }, min_ms, result);
+                results.push_back(result);
+            }
+
+            for (TextLayout::Mode mode : {TextLayout::GREEDY, TextLayout::MIN_RAGGEDNESS})
+            {
+                const char *op = (mode == TextLayout::GREEDY) ? "wrap_greedy" : "wrap_min_raggedness";
+                if (!wanted(only_op, op))
+                    continue;
+
+                std::string text;
+                while (text.size() < WRAP_BYTES)
+                /*
+                 * The corpus repeated into one document of lines
+                 */
+                {
+                    for (const std::string &line : corpus.lines)
+                    {
+                        text += line;
+                        text += '\n';
+                    }
+                }
+
+                TextLayout layout(fm);
+                result.op = op;
+                timePasses([&] {
+                    sink = sink + layout.Wrap(text, BREAK_WIDTH, mode).size();
+                    return Work{text.size(), text.size()};
+                }, min_ms, result);
+                results.push_back(result);
+            }
+
+            for (FontManager::Raster raster : {FontManager::LRTB, FontManager::PTBLR})
+            {
+                FontManager rfm(font, raster);
+                FontManager ufm(font, raster);
+                ufm.Utf8(true);
+                result.raster = RASTER_NAMES[raster];
+
+                for (uint16_t offset = 0; offset < 8; offset++)
+                {
+                    result.offset = offset;
+
+                    if (wanted(only_op, "rasterize_string"))
+                    {
+                        result.op = "rasterize_string";
+                        timePasses([&] {
+                            Work work{0, 0};
+                            for (const std::string &line : corpus.lines)
+                            {
+                                FontManager::Bitmap bm = rfm.Rasterize(line, offset);
+                                work.glyphs += line.size();
+                                work.bytes += bm.size;
+                            }
+                            return work;
+                        }, min_ms, result);
+                        results.push_back(result);
+                    }
+
+                    if (wanted(only_op, "rasterize_string_utf8"))
+                    {
+                        result.op = "rasterize_string_utf8";
+                        timePasses([&] {
+                            Work work{0, 0};
+                            for (size_t i = 0; i < corpus.utf8.size(); i++)
+                            {
+                                FontManager::Bitmap bm = ufm.Rasterize(corpus.utf8[i], offset);
+                                work.glyphs += corpus.lines[i].size();
+                                work.bytes += bm.size;
+                            }
+                            return work;
+                        }, min_ms, result);
+                        results.push_back(result);
+                    }
+
+                    if (wanted(only_op, "rasterize_char"))
+                    {
+                        result.op = "rasterize_char";
+                        timePasses([&] {
+                            Work work{0, 0};
+                            for (const std::string &line : corpus.lines)
+                            {
+                                for (char c : line)
+                                {
+                                    FontManager::Bitmap bm = rfm.Rasterize(static_cast<unsigned char>(c), offset);
+                                    work.glyphs++;
+                                    work.bytes += bm.size;
+                                }
+                            }
+                            return work;
+                        }, min_ms, result);
+                        results.push_back(result);
+                    }
+                }
+                result.offset = 0;
+                for (uint8_t scale = 2; scale <= 4; scale++)
+                {
+                    FontManager sfm(font, raster);
+                    sfm.Scale(scale, scale);
+
+                    if (wanted(only_op, SCALED_OPS[scale - 2][0]))
+                    {
+                        result.op = SCALED_OPS[scale - 2][0];
+                        timePasses([&] {
+                            Work work{0, 0};
+                            for (const std::string &line : corpus.lines)
+                            {
+                                FontManager::Bitmap bm = sfm.Rasterize(line);
+                                work.glyphs += line.size();
+                                work.bytes += bm.size;
+                            }
+                            return work;
+                        }, min_ms, result);
+                        results.push_back(result);
+                    }
+
+                    if (wanted(only_op, SCALED_OPS[scale - 2][1]))
+                    {
+                        std::vector<uint8_t> scaled;
+                        result.op = SCALED_OPS[scale - 2][1];
+                        timePasses([&] {
+                            Work work{0, 0};
+                            for (const std::string &line : corpus.lines)
+                            {
+                                work.glyphs += line.size();
+                                work.bytes += postScale(rfm.Rasterize(line), scale, scaled);
+                            }
+                            return work;
+                        }, min_ms, result);
+                        results.push_back(result);
+                    }
+                }
+                for (uint8_t turns = 1; turns <= 3; turns++)
+                {
+                    FontManager tfm(font, raster, static_cast<FontManager::Orientation>(turns));
+
+                    if (wanted(only_op, TURNED_OPS[turns - 1][0]))
+                    {
+                        result.op = TURNED_OPS[turns - 1][0];
+                        timePasses([&] {
+                            Work work{0, 0};
+                            for (const std::string &line : corpus.lines)
+                            {
+                                FontManager::Bitmap bm = tfm.Rasterize(line);
+                                work.glyphs += line.size();
+                                work.bytes += bm.size;
+                            }
+                            return work;
+                        }, min_ms, result);
+                        results.push_back(result);
+                    }
+
+                    if (wanted(only_op, TURNED_OPS[turns - 1][1]))
+                    {
+                        std::vector<uint8_t> turned;
+                        result.op = TURNED_OPS[turns - 1][1];
+                        timePasses([&] {
+                            Work work{0, 0};
+                            for (const std::string &line : corpus.lines)
+                            {
+                                work.glyphs += line.size();
+                                work.bytes += postTurn(rfm.Rasterize(line), turns, turned);
+                            }
+                            return work;
+                        }, min_ms, result);
+                        results.push_back(result);
+                    }
+                }
+                for (const auto &layout : LAYOUT_OPS)
+                {
+                    if (layout.base != raster)
+                        continue;
+                    FontManager lfm(font, layout.raster);
+                    result.raster = RASTER_NAMES[layout.raster];
+
+                    if (wanted(only_op, layout.ops[0]))
+                    {
+                        result.op = layout.ops[0];
+                        timePasses([&] {
+                            Work work{0, 0};
+                            for (const std::string &line : corpus.lines)
+                            {
+                                FontManager::Bitmap bm = lfm.Rasterize(line);
+                                work.glyphs += line.size();
+                                work.bytes += bm.size;
+                            }
+                            return work;
+                        }, min_ms, result);
+                        results.push_back(result);
+                    }
+
+                    if (wanted(only_op, layout.ops[1]))
+                    {
+                        std::vector<uint8_t> converted;
+                        result.op = layout.ops[1];
+                        timePasses([&] {
+                            Work work{0, 0};
+                            for (const std::string &line : corpus.lines)
+                            {
+                                work.glyphs += line.size();
+                                work.bytes += postLayout(rfm.Rasterize(line), layout.raster, converted);
+                            }
+                            return work;
+                        }, min_ms, result);
+                        results.push_back(result);
+                    }
+                }
+                for (const auto &gray : GRAY_OPS)
+                {
+                    if (raster != FontManager::LRTB)
+                        continue;
+                    FontManager gfm(font, gray.raster);
+                    FontManager ufm(font, gray.raster);
+                    gfm.Downsample(2);
+                    ufm.Downsample(2);
+#if RASTERFONT_GLYPH_CACHE
+                    ufm.GlyphCache(false);
+#endif
+                    result.raster = RASTER_NAMES[gray.raster];
+
+                    for (int op = 0; op < 2; op++)
+                    {
+                        FontManager &dfm = op ? ufm : gfm;
+                        if (!wanted(only_op, gray.ops[op]))
+                            continue;
+                        result.op = gray.ops[op];
+                        timePasses([&] {
+                            Work work{0, 0};
+                            for (const std::string &line : corpus.lines)
+                            {
+                                FontManager::Bitmap bm = dfm.Rasterize(line);
+                                work.glyphs += line.size();
+                                work.bytes += bm.size;
+                            }
+                            return work;
+                        }, min_ms, result);
+                        results.push_back(result);
+                    }
+
+                    if (wanted(only_op, gray.ops[2]))
+                    {
+                        std::vector<uint8_t> filtered;
+                        result.op = gray.ops[2];
+                        timePasses([&] {
+                            Work work{0, 0};
+                            for (const std::string &line : corpus.lines)
+                            {
+                                work.glyphs += line.size();
+                                work.bytes += postShrink(rfm.Rasterize(line), gray.raster, 2, filtered);
+                            }
+                            return work;
+                        }, min_ms, result);
+                        results.push_back(result);
+                    }
+                }
+                result.raster = "any";
+                result.offset = -1;
+            }
+        }
+    }
+
+    FILE *out = output ? fopen(output, "w") : stdout;
+    if (!out)
+    {
+        fprintf(stderr, "Cannot write %s\n", output);
+        return 1;
+    }
+    if (compression)
+        writeCompression(out, compressions, !strcmp(format, "json"));
+    else if (!strcmp(format, "json"))
+        writeJSON(out, results);
+    else
+        writeCSV(out, results);
+    if (output)
+        fclose(out);
+
+#if RASTERFONT_INSTRUMENT
+    DefaultInstrumentSink().Report(stderr);
+#endif
+    return 0;
+} // main
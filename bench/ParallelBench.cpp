@@ -0,0 +1,134 @@
+/*
+ Raster-Font Parallel Rasterizer benchmark
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "ParallelRasterizer.h"
+
+/*
+ * Usage: Raster-Font-parallel-bench [megabytes [font [width height]]]
+ *
+ * Rasterizes a synthetic log into pages with 1, 2, 4, 8 and one worker per
+ * hardware thread, checking every run produces the single worker pages.
+ */
+
+#define RUNS 3 ///< Best of
+
+/**
+ * @brief Builds a log of roughly the size given
+ */
+static std::string logText(size_t bytes)
+{
+    static const char *levels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+    static const char *words[] = {"request", "served", "in", "ms", "cache", "miss", "for", "page", "user", "retry", "connection", "closed", "by", "peer"};
+    std::string text;
+    unsigned seed = 1;
+
+    text.reserve(bytes + 256);
+    while (text.size() < bytes)
+    {
+        char stamp[40];
+        seed = (seed * 1103515245) + 12345;
+        snprintf(stamp, sizeof(stamp), "2019-06-%02u %02u:%02u:%02u ", 1 + (seed >> 8) % 28, (seed >> 12) % 24, (seed >> 16) % 60, (seed >> 20) % 60);
+        text += stamp;
+        text += levels[(seed >> 4) % 4];
+        for (unsigned w = (seed >> 24) % 24; w; w--)
+        {
+            seed = (seed * 1103515245) + 12345;
+            text += ' ';
+            text += words[(seed >> 16) % 14];
+        }
+        text += '\n';
+    }
+    return text;
+} // logText
+
+int main(int argc, char *argv[])
+{
+    size_t megabytes = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 8;
+    uint8_t font = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 0;
+    uint16_t width = (argc > 4) ? strtoul(argv[3], nullptr, 10) : 384;
+    uint16_t height = (argc > 4) ? strtoul(argv[4], nullptr, 10) : 640;
+
+    if (font >= FontManager::FontCount())
+    {
+        fprintf(stderr, "Font %u out of range, %u fonts\n", font, FontManager::FontCount());
+        return 1;
+    }
+
+    std::string text = logText(megabytes << 20);
+    unsigned hardware = std::thread::hardware_concurrency();
+    std::vector<unsigned> threads = {1, 2, 4, 8};
+    if (hardware > 8 || (hardware & (hardware - 1)))
+        threads.push_back(hardware);
+
+    printf("Font %s, %zu bytes, %ux%u pages, %u hardware threads\n", FontManager(font, FontManager::LRTB).FontName(), text.size(), width, height, hardware);
+    printf("%-6s %8s %8s %10s %10s %8s %8s\n", "raster", "threads", "pages", "ms", "MB/s", "speedup", "steals");
+
+    int failures = 0;
+    for (FontManager::Raster raster : {FontManager::LRTB, FontManager::PTBLR})
+    {
+        std::vector<ParallelRasterizer::Page> reference;
+        double single = 0;
+
+        for (unsigned t : threads)
+        {
+            ParallelRasterizer pr(font, raster, t);
+            std::vector<ParallelRasterizer::Page> pages;
+            double best = 0;
+
+            for (int run = 0; run < RUNS; run++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                pages = pr.Rasterize(text, width, height);
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (!run || ms < best)
+                    best = ms;
+            }
+
+            if (t == 1)
+            {
+                single = best;
+                reference = pages;
+            }
+            else if (pages.size() != reference.size())
+            {
+                failures++;
+            }
+            else
+            {
+                for (size_t i = 0; i < pages.size(); i++)
+                {
+                    if (pages[i].data != reference[i].data)
+                        failures++;
+                }
+            }
+
+            printf("%-6s %8u %8zu %10.1f %10.1f %8.2f %8llu\n", raster == FontManager::LRTB ? "LRTB" : "PTBLR", t, pages.size(), best,
+                   (text.size() / 1048576.0) / (best / 1000), single / best, (unsigned long long)pr.Steals());
+        }
+    }
+
+    if (failures)
+        printf("%d pages differ from the single worker pages\n", failures);
+    return failures ? 1 : 0;
+} // main
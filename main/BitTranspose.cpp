@@ -0,0 +1,1074 @@
+/*
+ Raster-Font Library Bit Transpose
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "BitTranspose.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TRANSPOSE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define TRANSPOSE_ARM_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define MAX_PAGES (((255 + 7 - 1) / 8) + 1) ///< Pages of the tallest character at the largest phase
+#define PAD_PAGES 3                          ///< Pages read beyond the last by the widest kernel
+
+static const uint8_t MSBITS[8] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01}; ///< Segment bit mask
+
+/**
+ * @brief The bits of every byte reversed, at compile time
+ */
+struct ReverseTable
+{
+    uint8_t reverse[256];
+
+    constexpr ReverseTable() : reverse{}
+    {
+        for (int byte = 0; byte < 256; byte++)
+        {
+            for (int bit = 0; bit < 8; bit++)
+            {
+                if (byte & (1 << bit))
+                    reverse[byte] |= 0x80 >> bit;
+            }
+        }
+    }
+};
+
+static constexpr ReverseTable REVERSE{}; ///< Bits of a byte reversed
+
+const uint8_t *const BIT_REVERSE = REVERSE.reverse;
+
+/**
+ * @brief Transposes page blocks into page columns
+ *
+ * Block byte 8*page + bit holds the font byte of the row at that bit of that page.
+ *
+ * @param block the gathered rows, padded with zero pages
+ * @param pages the number of pages to write
+ * @param columns the number of columns to write, up to 8
+ * @param dest the first column of page 0
+ * @param stride the bytes between the start of each page
+ */
+typedef void (*block_transpose_t)(const uint8_t *block, uint8_t pages, uint8_t columns, uint8_t *dest, uint16_t stride);
+
+/**
+ * @brief Bit at a time reference
+ */
+static void blocksScalar(const uint8_t *block, uint8_t pages, uint8_t columns, uint8_t *dest, uint16_t stride)
+{
+    for (uint8_t page = 0; page < pages; page++, dest += stride)
+    {
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            uint8_t word = block[(8 * page) + bit];
+            for (uint8_t seg = 0; seg < columns; seg++)
+            {
+                if (word & MSBITS[seg]) // Font bit is set in this bit position
+                {
+                    dest[seg] |= 1 << bit;
+                }
+            }
+        }
+    }
+} // blocksScalar
+
+/**
+ * @brief Portable 8x8 transpose of a 64 bit word
+ *
+ * Word byte r is block row r; word byte 7-c of the result is column c.
+ */
+static void blocksSWAR(const uint8_t *block, uint8_t pages, uint8_t columns, uint8_t *dest, uint16_t stride)
+{
+    for (uint8_t page = 0; page < pages; page++, dest += stride, block += 8)
+    {
+        uint64_t x = 0;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            x |= (uint64_t)block[bit] << (8 * bit);
+        }
+        if (!x)
+            continue;
+
+        uint64_t t;
+        t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+        x = x ^ t ^ (t << 7);
+        t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+        x = x ^ t ^ (t << 14);
+        t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+        x = x ^ t ^ (t << 28);
+
+        for (uint8_t seg = 0; seg < columns; seg++)
+        {
+            dest[seg] |= (uint8_t)(x >> (8 * (7 - seg)));
+        }
+    }
+} // blocksSWAR
+
+#if TRANSPOSE_X86
+/**
+ * @brief SSE2, the byte MSB masks of two pages of rows give a column of each page
+ */
+__attribute__((target("sse2"))) static void blocksSSE2(const uint8_t *block, uint8_t pages, uint8_t columns, uint8_t *dest, uint16_t stride)
+{
+    for (uint8_t page = 0; page < pages; page += 2, dest += 2 * stride)
+    {
+        __m128i rows = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + (8 * page)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(rows, _mm_setzero_si128())) == 0xFFFF)
+            continue;
+
+        bool second = (page + 1) < pages;
+        for (uint8_t seg = 0; seg < columns; seg++)
+        {
+            int mask = _mm_movemask_epi8(rows);
+            dest[seg] |= (uint8_t)mask;
+            if (second)
+                dest[stride + seg] |= (uint8_t)(mask >> 8);
+            rows = _mm_add_epi8(rows, rows); // Next column into the MSB
+        }
+    }
+} // blocksSSE2
+
+/**
+ * @brief AVX2, the byte MSB masks of four pages of rows give a column of each page
+ */
+__attribute__((target("avx2"))) static void blocksAVX2(const uint8_t *block, uint8_t pages, uint8_t columns, uint8_t *dest, uint16_t stride)
+{
+    for (uint8_t page = 0; page < pages; page += 4, dest += 4 * stride)
+    {
+        __m256i rows = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + (8 * page)));
+        if (_mm256_testz_si256(rows, rows))
+            continue;
+
+        uint8_t count = (pages - page) < 4 ? (pages - page) : 4;
+        uint32_t masks[8];
+        for (uint8_t seg = 0; seg < columns; seg++)
+        {
+            masks[seg] = (uint32_t)_mm256_movemask_epi8(rows);
+            rows = _mm256_add_epi8(rows, rows); // Next column into the MSB
+        }
+        for (uint8_t p = 0; p < count; p++)
+        /*
+         * Each page row at a time
+         */
+        {
+            uint8_t *pixel = dest + (p * stride);
+            for (uint8_t seg = 0; seg < columns; seg++)
+            {
+                pixel[seg] |= (uint8_t)(masks[seg] >> (8 * p));
+            }
+        }
+    }
+} // blocksAVX2
+#endif
+
+#if TRANSPOSE_ARM_NEON
+/**
+ * @brief NEON, the byte MSBs of two pages of rows shifted to their bit and summed per page
+ */
+static void blocksNEON(const uint8_t *block, uint8_t pages, uint8_t columns, uint8_t *dest, uint16_t stride)
+{
+    static const int8_t lanes[16] = {0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7};
+    const int8x16_t shift = vld1q_s8(lanes);
+
+    for (uint8_t page = 0; page < pages; page += 2, dest += 2 * stride)
+    {
+        uint8x16_t rows = vld1q_u8(block + (8 * page));
+        if (!vmaxvq_u8(rows))
+            continue;
+
+        bool second = (page + 1) < pages;
+        for (uint8_t seg = 0; seg < columns; seg++)
+        {
+            uint8x16_t bits = vshlq_u8(vshrq_n_u8(rows, 7), shift);
+            dest[seg] |= vaddv_u8(vget_low_u8(bits));
+            if (second)
+                dest[stride + seg] |= vaddv_u8(vget_high_u8(bits));
+            rows = vshlq_n_u8(rows, 1); // Next column into the MSB
+        }
+    }
+} // blocksNEON
+#endif
+
+static const block_transpose_t KERNELS[TRANSPOSE_KERNELS] = {
+    blocksScalar,
+    blocksSWAR,
+#if TRANSPOSE_X86
+    blocksSSE2,
+    blocksAVX2,
+#else
+    nullptr,
+    nullptr,
+#endif
+#if TRANSPOSE_ARM_NEON
+    blocksNEON,
+#else
+    nullptr,
+#endif
+};
+
+static const char *KERNEL_NAMES[TRANSPOSE_KERNELS] = {"scalar", "swar", "sse2", "avx2", "neon"};
+
+/**
+ * @brief Is the kernel compiled in and supported by this CPU
+ *
+ * @param kernel the kernel
+ * @return true if the kernel can be selected
+ */
+bool TransposeKernelSupported(TransposeKernel kernel)
+{
+    if (kernel >= TRANSPOSE_KERNELS || !KERNELS[kernel])
+        return false;
+
+#if TRANSPOSE_X86
+    __builtin_cpu_init();
+    if (kernel == TRANSPOSE_SSE2)
+        return __builtin_cpu_supports("sse2");
+    if (kernel == TRANSPOSE_AVX2)
+        return __builtin_cpu_supports("avx2");
+#endif
+    return true;
+} // TransposeKernelSupported
+
+/**
+ * @brief The fastest kernel this CPU supports
+ */
+static TransposeKernel bestKernel()
+{
+    for (int kernel = TRANSPOSE_KERNELS - 1; kernel > TRANSPOSE_SWAR; kernel--)
+    {
+        if (TransposeKernelSupported(static_cast<TransposeKernel>(kernel)))
+            return static_cast<TransposeKernel>(kernel);
+    }
+    return TRANSPOSE_SWAR;
+} // bestKernel
+
+static TransposeKernel active_kernel = bestKernel(); ///< The kernel in use, chosen by CPU feature detection
+
+/**
+ * @brief The kernel in use
+ *
+ * @return the active kernel
+ */
+TransposeKernel ActiveTransposeKernel()
+{
+    return active_kernel;
+} // ActiveTransposeKernel
+
+/**
+ * @brief Overrides the kernel chosen by CPU feature detection, e.g. to benchmark
+ *
+ * Not to be called while characters are being transposed on other threads.
+ *
+ * @param kernel the kernel to use
+ * @return false if the kernel is not supported, the active kernel being unchanged
+ */
+bool SelectTransposeKernel(TransposeKernel kernel)
+{
+    if (!TransposeKernelSupported(kernel))
+        return false;
+    active_kernel = kernel;
+    return true;
+} // SelectTransposeKernel
+
+/**
+ * @brief The name of a kernel
+ *
+ * @param kernel the kernel
+ * @return the kernel name
+ */
+const char *TransposeKernelName(TransposeKernel kernel)
+{
+    return (kernel < TRANSPOSE_KERNELS) ? KERNEL_NAMES[kernel] : "unknown";
+} // TransposeKernelName
+
+/**
+ * @brief Puts the gathered rows of each page block in the bit order of the page layout
+ *
+ * Rows are gathered top row first, or bottom row first for bottom up pages,
+ * each at the bit of its page it lands on; pages with the top row in the MSB
+ * have the rows of each block reversed.
+ *
+ * @param block the gathered rows
+ * @param pages the number of pages
+ * @param order the page layout
+ */
+static void orderBlocks(uint8_t *block, uint8_t pages, PageOrder order)
+{
+    if (order != PAGE_MSB_TOP)
+        return;
+
+    for (uint8_t page = 0; page < pages; page++, block += 8)
+    {
+        uint64_t rows;
+        memcpy(&rows, block, 8);
+        rows = __builtin_bswap64(rows);
+        memcpy(block, &rows, 8);
+    }
+} // orderBlocks
+
+/**
+ * @brief Transposes a L-R/T-B character bitmap into T-B/L-R pages
+ *
+ * Each column byte of the font is gathered, row by row, into blocks of eight
+ * rows aligned to the destination pages, which the active kernel transposes
+ * and ORs into the page columns. Bottom up pages gather the rows from the
+ * bottom of the character, the phase then being from the bottom of the first page.
+ *
+ * @param char_bitmap the L-R/T-B character bitmap
+ * @param width character width in pixels
+ * @param height character height in pixels
+ * @param phase the bits the character is offset from the top of the first page
+ * @param pages the destination, page 0 columns first
+ * @param stride the bytes between the start of each page
+ * @param order the page layout
+ */
+void TransposeChar(const uint8_t *char_bitmap, uint8_t width, uint8_t height, uint8_t phase, uint8_t *pages, uint16_t stride,
+                   PageOrder order)
+{
+    if (!width || !height)
+        return;
+
+    uint8_t block[8 * (MAX_PAGES + PAD_PAGES)];
+    uint8_t horizontal_read_bytes = 1 + ((width - 1) / 8);          // Bytes to read for horizontal
+    uint8_t page_count = (((height + phase) - 1) / 8) + 1;          // Pages to write
+    block_transpose_t kernel = KERNELS[active_kernel];
+
+    for (uint8_t column = 0; column < horizontal_read_bytes; column++)
+    {
+        memset(block, 0, 8 * (page_count + PAD_PAGES));
+        for (uint8_t row = 0; row < height; row++)
+        {
+            uint8_t gathered = (order == PAGE_BOTTOM_UP) ? height - 1 - row : row;
+            block[gathered + phase] = char_bitmap[(row * horizontal_read_bytes) + column];
+        }
+        orderBlocks(block, page_count, order);
+
+        uint8_t columns = (width - (column * 8)) < 8 ? (width - (column * 8)) : 8;
+        kernel(block, page_count, columns, pages + (column * 8), stride);
+    }
+} // TransposeChar
+
+/**
+ * @brief Each bit of every byte repeated scale times, MSB first, at compile time
+ */
+template <typename Word, uint8_t scale>
+struct SpreadTable
+{
+    Word spread[256];
+
+    constexpr SpreadTable() : spread{}
+    {
+        for (int byte = 0; byte < 256; byte++)
+        {
+            for (int bit = 0; bit < 8; bit++)
+            {
+                if (byte & (1 << bit))
+                    spread[byte] |= (Word)(((1u << scale) - 1) << (bit * scale));
+            }
+        }
+    }
+};
+
+static constexpr SpreadTable<uint16_t, 2> SPREAD2{}; ///< Bits of a byte doubled
+static constexpr SpreadTable<uint32_t, 3> SPREAD3{}; ///< Bits of a byte tripled
+static constexpr SpreadTable<uint32_t, 4> SPREAD4{}; ///< Bits of a byte quadrupled
+
+#if TRANSPOSE_X86
+/**
+ * @brief BMI2 bit deposit of each bit at the low end of its group, the multiply filling the group
+ */
+__attribute__((target("bmi2"))) static uint64_t spreadPDEP(uint8_t byte, uint8_t scale)
+{
+    uint64_t lows = 0;
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+        lows |= 1ull << (bit * scale);
+    }
+    return _pdep_u64(byte, lows) * ((1ull << scale) - 1);
+} // spreadPDEP
+
+static const bool has_bmi2 = (__builtin_cpu_init(), __builtin_cpu_supports("bmi2")); ///< pdep available
+#endif
+
+/**
+ * @brief Each bit of a byte repeated scale times, MSB first
+ *
+ * Scales 2 to 4 are a table lookup; larger scales a BMI2 bit deposit where
+ * the CPU has it, else bit at a time.
+ *
+ * @param byte the byte
+ * @param scale the times to repeat each bit, up to MAX_SCALE
+ * @return the scale bytes of spread bits, the first in the most significant
+ */
+static inline uint64_t spreadBits(uint8_t byte, uint8_t scale)
+{
+    switch (scale)
+    {
+    case 1:
+        return byte;
+    case 2:
+        return SPREAD2.spread[byte];
+    case 3:
+        return SPREAD3.spread[byte];
+    case 4:
+        return SPREAD4.spread[byte];
+    }
+
+#if TRANSPOSE_X86
+    if (has_bmi2)
+        return spreadPDEP(byte, scale);
+#endif
+    uint64_t spread = 0;
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+        if (byte & (1 << bit))
+            spread |= ((1ull << scale) - 1) << (bit * scale);
+    }
+    return spread;
+} // spreadBits
+
+/**
+ * @brief Scales L-R bitmap rows horizontally, each pixel repeated scale times
+ *
+ * @param rows the rows, MSB first, each padded to whole bytes
+ * @param width the row width in pixels
+ * @param height the number of rows
+ * @param scale the times to repeat each pixel, up to MAX_SCALE
+ * @param scaled the scaled rows, scale bytes for each byte of a row
+ */
+void ScaleRows(const uint8_t *rows, uint8_t width, uint8_t height, uint8_t scale, uint8_t *scaled)
+{
+    uint16_t bytes = (1 + ((width - 1) / 8)) * height;
+    for (uint16_t b = 0; b < bytes; b++)
+    {
+        uint64_t spread = spreadBits(rows[b], scale);
+        for (int8_t byte = scale - 1; byte >= 0; byte--)
+        {
+            *scaled++ = spread >> (8 * byte);
+        }
+    }
+} // ScaleRows
+
+/**
+ * @brief Transposes a L-R/T-B character bitmap into T-B/L-R pages, scaled by whole pixels
+ *
+ * Each column byte of the font is spread across scale column bytes, and each
+ * row gathered y_scale times into the page blocks, which the active kernel
+ * transposes as for TransposeChar, in the same page layouts. The unscaled character is never laid out.
+ *
+ * @param char_bitmap the L-R/T-B character bitmap
+ * @param width character width in pixels, times x_scale at most 255
+ * @param height character height in pixels, times y_scale at most 255
+ * @param x_scale the times to repeat each column, up to MAX_SCALE
+ * @param y_scale the times to repeat each row, up to MAX_SCALE
+ * @param phase the bits the character is offset from the top of the first page
+ * @param pages the destination, page 0 columns first
+ * @param stride the bytes between the start of each page
+ * @param order the page layout
+ */
+void TransposeScaledChar(const uint8_t *char_bitmap, uint8_t width, uint8_t height, uint8_t x_scale, uint8_t y_scale, uint8_t phase,
+                         uint8_t *pages, uint16_t stride, PageOrder order)
+{
+    if (!width || !height)
+        return;
+
+    uint8_t block[8 * (MAX_PAGES + PAD_PAGES)];
+    uint64_t spread[255];
+    uint8_t horizontal_read_bytes = 1 + ((width - 1) / 8);                     // Bytes to read for horizontal
+    uint16_t scaled_width = width * x_scale;
+    uint8_t scaled_height = height * y_scale;
+    uint8_t page_count = (((scaled_height + phase) - 1) / 8) + 1;              // Pages to write
+    block_transpose_t kernel = KERNELS[active_kernel];
+
+    for (uint8_t column = 0; column < horizontal_read_bytes; column++)
+    {
+        for (uint8_t row = 0; row < height; row++)
+        {
+            spread[row] = spreadBits(char_bitmap[(row * horizontal_read_bytes) + column], x_scale);
+        }
+
+        for (uint8_t byte = 0; byte < x_scale; byte++)
+        /*
+         * Each scaled column byte spread from the font column byte
+         */
+        {
+            uint16_t first = ((column * x_scale) + byte) * 8; // First pixel column of the scaled byte
+            if (first >= scaled_width)
+                break;
+
+            uint8_t shift = 8 * (x_scale - 1 - byte);
+            memset(block, 0, 8 * (page_count + PAD_PAGES));
+            for (uint8_t row = 0; row < height; row++)
+            {
+                uint8_t gathered = (order == PAGE_BOTTOM_UP) ? height - 1 - row : row;
+                memset(block + phase + (gathered * y_scale), (uint8_t)(spread[row] >> shift), y_scale);
+            }
+            orderBlocks(block, page_count, order);
+
+            uint8_t columns = (scaled_width - first) < 8 ? (scaled_width - first) : 8;
+            kernel(block, page_count, columns, pages + first, stride);
+        }
+    }
+} // TransposeScaledChar
+
+/**
+ * @brief Portable 8x8 transpose about the anti-diagonal of a 64 bit word
+ *
+ * Word byte r is block row r, its MSB column 0; result row r, column c is
+ * row 7-c, column 7-r.
+ */
+static inline uint64_t antiTranspose(uint64_t x)
+{
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    return x ^ t ^ (t << 28);
+} // antiTranspose
+
+/**
+ * @brief The bits of each byte of a 64 bit word reversed
+ */
+static inline uint64_t reverseBytes(uint64_t x)
+{
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    return ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+} // reverseBytes
+
+/**
+ * @brief Turns a L-R/T-B character bitmap clockwise by quarter turns
+ *
+ * Quarter turns gather each 8x8 bit block of the character into a 64 bit word
+ * and turn it by a transpose and a reversal, rows for clockwise and bits for
+ * anticlockwise, each turned block written once. The half turn reverses each
+ * row by table, in reverse order. Bits beyond the width of a row are ignored.
+ *
+ * @param char_bitmap the L-R/T-B character bitmap
+ * @param width character width in pixels
+ * @param height character height in pixels
+ * @param turns the quarter turns clockwise, 0 to 3
+ * @param rotated the turned bitmap, its rows padded to whole bytes; width rows
+ *                of the height for quarter turns, else as the character
+ */
+void RotateChar(const uint8_t *char_bitmap, uint8_t width, uint8_t height, uint8_t turns, uint8_t *rotated)
+{
+    if (!width || !height)
+        return;
+
+    uint8_t read_bytes = 1 + ((width - 1) / 8);       // Bytes of each character row
+    uint8_t blocks = 1 + ((height - 1) / 8);          // Blocks down the character, bytes of each quarter turned row
+    uint8_t pad = (8 * read_bytes) - width;           // Bits beyond the width of the last row byte
+    uint8_t last = 0xFF << pad;                       // Mask of the last row byte
+
+    switch (turns % 4)
+    {
+    case 0:
+        for (uint16_t byte = 0; byte < read_bytes * height; byte++)
+        {
+            rotated[byte] = char_bitmap[byte] & (((byte % read_bytes) == read_bytes - 1) ? last : 0xFF);
+        }
+        break;
+
+    case 2:
+        for (uint8_t row = 0; row < height; row++)
+        /*
+         * Each row reversed into the mirrored row, shifted back to the left edge
+         */
+        {
+            const uint8_t *line = char_bitmap + (row * read_bytes);
+            uint8_t *dest = rotated + ((height - 1 - row) * read_bytes);
+            for (uint8_t byte = 0; byte < read_bytes; byte++)
+            {
+                uint8_t source = read_bytes - 1 - byte;
+                uint8_t word = REVERSE.reverse[line[source] & ((source == read_bytes - 1) ? last : 0xFF)];
+                dest[byte] = word << pad;
+                if (pad && source)
+                    dest[byte] |= REVERSE.reverse[line[source - 1]] >> (8 - pad);
+            }
+        }
+        break;
+
+    default:
+    {
+        bool clockwise = (turns % 4) == 1;
+        uint8_t top = clockwise ? (8 * blocks) - height : 0; // Blank rows above the character, aligning its last row to a block
+
+        for (uint8_t block = 0; block < blocks; block++)
+        {
+            for (uint8_t column = 0; column < read_bytes; column++)
+            {
+                uint64_t x = 0;
+                for (uint8_t bit = 0; bit < 8; bit++)
+                /*
+                 * Gather the block rows, byte r being row r
+                 */
+                {
+                    int16_t row = (8 * block) + bit - top;
+                    if (row >= 0 && row < height)
+                        x |= (uint64_t)(char_bitmap[(row * read_bytes) + column] & ((column == read_bytes - 1) ? last : 0xFF)) << (8 * bit);
+                }
+                x = antiTranspose(x);
+                x = clockwise ? __builtin_bswap64(x) : reverseBytes(x);
+
+                for (uint8_t bit = 0; bit < 8; bit++)
+                /*
+                 * Scatter the turned block rows, the character columns
+                 */
+                {
+                    int16_t turned = clockwise ? (8 * column) + bit : (8 * (read_bytes - 1 - column)) + bit - pad;
+                    if (turned >= 0 && turned < width)
+                        rotated[(turned * blocks) + (clockwise ? blocks - 1 - block : block)] = x >> (8 * bit);
+                }
+            }
+        }
+        break;
+    }
+    }
+} // RotateChar
+
+/**
+ * @brief The pixel bit of each byte of 8 pixels, for each pixel width
+ *
+ * Byte j of 8 pixels of b bytes belongs to pixel j/b, selected by bit 7-j/b of
+ * the bitmap byte.
+ */
+struct SelectorTable
+{
+    uint8_t selector[MAX_PIXEL_BYTES][8 * MAX_PIXEL_BYTES];
+
+    constexpr SelectorTable() : selector{}
+    {
+        for (int bytes = 1; bytes <= MAX_PIXEL_BYTES; bytes++)
+        {
+            for (int byte = 0; byte < 8 * bytes; byte++)
+            {
+                selector[bytes - 1][byte] = 0x80 >> (byte / bytes);
+            }
+        }
+    }
+};
+
+static constexpr SelectorTable SELECTORS{}; ///< Pixel bit of each pixel byte
+
+/**
+ * @brief Expands L-R bitmap rows into rows of color pixels
+ *
+ * @param rows the bitmap rows, MSB first
+ * @param row_bytes the bytes from one bitmap row to the next
+ * @param width the row width in pixels
+ * @param height the number of bitmap rows
+ * @param y_scale the times to expand each bitmap row
+ * @param pixel_bytes the bytes of a pixel
+ * @param selector the pixel bit of each byte of 8 pixels
+ * @param foreground 8 foreground pixels
+ * @param background 8 background pixels, nullptr to leave background pixels as they are
+ * @param pixels the first pixel of the first row
+ * @param stride the bytes from one pixel row to the next
+ */
+typedef void (*pixel_expand_t)(const uint8_t *rows, uint16_t row_bytes, uint16_t width, uint8_t height, uint8_t y_scale,
+                               uint8_t pixel_bytes, const uint8_t *selector, const uint8_t *foreground,
+                               const uint8_t *background, uint8_t *pixels, uint16_t stride);
+
+/**
+ * @brief Sets the foreground pixel bytes of part of 8 pixels, leaving the others
+ *
+ * @param byte the bitmap byte
+ * @param count the pixel bytes to set
+ * @param selector the pixel bit of each byte
+ * @param foreground 8 foreground pixels
+ * @param pixels the first pixel
+ */
+static inline void expandForeground(uint8_t byte, uint8_t count, const uint8_t *selector, const uint8_t *foreground, uint8_t *pixels)
+{
+    for (uint8_t b = 0; b < count; b++)
+    {
+        if (byte & selector[b])
+            pixels[b] = foreground[b];
+    }
+} // expandForeground
+
+/**
+ * @brief Copies the first bytes of expanded pixels by fixed size moves
+ *
+ * @param pixels the destination
+ * @param expanded 8 expanded pixels
+ * @param count the bytes to copy, less than 8 pixels
+ */
+static inline void copyPixels(uint8_t *pixels, const uint8_t *expanded, uint8_t count)
+{
+    for (uint8_t size = 16; size; size /= 2)
+    {
+        if (count & size)
+        {
+            memcpy(pixels, expanded, size);
+            pixels += size;
+            expanded += size;
+        }
+    }
+} // copyPixels
+
+/**
+ * @brief Byte at a time reference
+ */
+static void expandScalar(const uint8_t *rows, uint16_t row_bytes, uint16_t width, uint8_t height, uint8_t y_scale,
+                         uint8_t pixel_bytes, [[maybe_unused]] const uint8_t *selector, const uint8_t *foreground,
+                         const uint8_t *background, uint8_t *pixels, uint16_t stride)
+{
+    for (uint16_t row = 0; row < height * y_scale; row++)
+    {
+        const uint8_t *bits = rows + (row_bytes * (row / y_scale));
+        uint8_t *out = pixels + ((size_t)stride * row);
+        for (uint16_t x = 0; x < width; x++, out += pixel_bytes)
+        {
+            bool set = bits[x / 8] & (0x80 >> (x % 8));
+            if (set || background)
+                memcpy(out, set ? foreground : background, pixel_bytes);
+        }
+    }
+} // expandScalar
+
+/**
+ * @brief Portable 64 bit word, the selected bits of 8 pixel bytes widened to byte masks
+ */
+static void expandSWAR(const uint8_t *rows, uint16_t row_bytes, uint16_t width, uint8_t height, uint8_t y_scale,
+                       uint8_t pixel_bytes, const uint8_t *selector, const uint8_t *foreground,
+                       const uint8_t *background, uint8_t *pixels, uint16_t stride)
+{
+    const uint64_t LOWS = 0x7F7F7F7F7F7F7F7FULL;
+    uint8_t bytes = 8 * pixel_bytes;
+    uint16_t whole = width / 8;
+    uint8_t tail = (width % 8) * pixel_bytes;
+    uint64_t select[MAX_PIXEL_BYTES], fore[MAX_PIXEL_BYTES], back[MAX_PIXEL_BYTES] = {};
+    memcpy(select, selector, bytes);
+    memcpy(fore, foreground, bytes);
+    if (background)
+        memcpy(back, background, bytes);
+
+    auto expand = [&](uint8_t byte, uint8_t *out) {
+        uint64_t broadcast = byte * 0x0101010101010101ULL;
+        for (uint8_t word = 0; word < pixel_bytes; word++, out += 8)
+        {
+            uint64_t set = broadcast & select[word];
+            uint64_t mask = (((((set & LOWS) + LOWS) | set) & ~LOWS) >> 7) * 0xFF; // 0xFF for each non zero byte
+            uint64_t under = back[word];
+            if (!background)
+                memcpy(&under, out, 8);
+            uint64_t blend = (fore[word] & mask) | (under & ~mask);
+            memcpy(out, &blend, 8);
+        }
+    };
+
+    for (uint8_t row = 0; row < height; row++)
+    {
+        const uint8_t *bits = rows + (row_bytes * row);
+        for (uint8_t repeat = 0; repeat < y_scale; repeat++)
+        {
+            uint8_t *out = pixels + ((size_t)stride * ((row * y_scale) + repeat));
+            for (uint16_t b = 0; b < whole; b++, out += bytes)
+            {
+                expand(bits[b], out);
+            }
+            if (tail && !background)
+                expandForeground(bits[whole], tail, selector, foreground, out);
+            else if (tail)
+            {
+                uint8_t last[8 * MAX_PIXEL_BYTES];
+                expand(bits[whole], last);
+                copyPixels(out, last, tail);
+            }
+        }
+    }
+} // expandSWAR
+
+#if TRANSPOSE_X86
+/**
+ * @brief Loads a lane of 8 pixels of a pattern, zero beyond the pattern
+ *
+ * @param pattern 8 pixels, nullptr for zero
+ * @param bytes the bytes of 8 pixels
+ * @param lane the 16 byte lane
+ */
+__attribute__((target("sse2"))) static inline __m128i loadLaneSSE2(const uint8_t *pattern, uint8_t bytes, uint8_t lane)
+{
+    if (!pattern || (16 * lane) >= bytes)
+        return _mm_setzero_si128();
+    if (bytes - (16 * lane) == 8)
+        return _mm_loadl_epi64((const __m128i *)(pattern + (16 * lane)));
+    return _mm_loadu_si128((const __m128i *)(pattern + (16 * lane)));
+} // loadLaneSSE2
+
+/**
+ * @brief Stores the first bytes of a vector by fixed size moves
+ *
+ * @param out the destination
+ * @param v the vector
+ * @param count the bytes to store, up to 16
+ */
+__attribute__((target("sse2"))) static inline void storeBytesSSE2(uint8_t *out, __m128i v, uint8_t count)
+{
+    if (count == 16)
+    {
+        _mm_storeu_si128((__m128i *)out, v);
+        return;
+    }
+    if (count & 8)
+    {
+        _mm_storel_epi64((__m128i *)out, v);
+        v = _mm_srli_si128(v, 8);
+        out += 8;
+    }
+    uint32_t word = _mm_cvtsi128_si32(v);
+    if (count & 4)
+    {
+        memcpy(out, &word, 4);
+        word = _mm_cvtsi128_si32(_mm_srli_si128(v, 4));
+        out += 4;
+    }
+    if (count & 2)
+    {
+        memcpy(out, &word, 2);
+        word >>= 16;
+        out += 2;
+    }
+    if (count & 1)
+        *out = word;
+} // storeBytesSSE2
+
+/**
+ * @brief The foreground where the broadcast bitmap byte has the selected bit, else under
+ */
+__attribute__((target("sse2"))) static inline __m128i blendSSE2(__m128i broadcast, __m128i select, __m128i fore, __m128i under)
+{
+    __m128i mask = _mm_cmpeq_epi8(_mm_and_si128(broadcast, select), select);
+    return _mm_or_si128(_mm_and_si128(mask, fore), _mm_andnot_si128(mask, under));
+} // blendSSE2
+
+/**
+ * @brief SSE2, the bitmap byte broadcast and compared with the selectors, 16 pixel bytes per step
+ */
+__attribute__((target("sse2"))) static void expandSSE2(const uint8_t *rows, uint16_t row_bytes, uint16_t width, uint8_t height,
+                                                        uint8_t y_scale, uint8_t pixel_bytes, const uint8_t *selector,
+                                                        const uint8_t *foreground, const uint8_t *background, uint8_t *pixels,
+                                                        uint16_t stride)
+{
+    uint8_t bytes = 8 * pixel_bytes;
+    uint8_t low = (bytes < 16) ? bytes : 16; // Bytes of the first lane
+    uint16_t whole = width / 8;
+    uint8_t tail = (width % 8) * pixel_bytes;
+    __m128i select[2] = {loadLaneSSE2(selector, bytes, 0), loadLaneSSE2(selector, bytes, 1)};
+    __m128i fore[2] = {loadLaneSSE2(foreground, bytes, 0), loadLaneSSE2(foreground, bytes, 1)};
+    __m128i back[2] = {loadLaneSSE2(background, bytes, 0), loadLaneSSE2(background, bytes, 1)};
+
+    for (uint8_t row = 0; row < height; row++)
+    {
+        const uint8_t *bits = rows + (row_bytes * row);
+        for (uint8_t repeat = 0; repeat < y_scale; repeat++)
+        {
+            uint8_t *out = pixels + ((size_t)stride * ((row * y_scale) + repeat));
+            for (uint16_t b = 0; b < whole; b++, out += bytes)
+            /*
+             * 8 pixels over the background, or the pixels there for transparent backgrounds
+             */
+            {
+                __m128i broadcast = _mm_set1_epi8(bits[b]);
+                storeBytesSSE2(out, blendSSE2(broadcast, select[0], fore[0], background ? back[0] : loadLaneSSE2(out, low, 0)), low);
+                if (bytes > 16)
+                    storeBytesSSE2(out + 16, blendSSE2(broadcast, select[1], fore[1], background ? back[1] : loadLaneSSE2(out + 16, 8, 0)), 8);
+            }
+            if (tail && !background)
+                expandForeground(bits[whole], tail, selector, foreground, out);
+            else if (tail)
+            /*
+             * The pixels of the last part byte stored straight from the vectors
+             */
+            {
+                __m128i broadcast = _mm_set1_epi8(bits[whole]);
+                storeBytesSSE2(out, blendSSE2(broadcast, select[0], fore[0], back[0]), (tail < 16) ? tail : 16);
+                if (tail > 16)
+                    storeBytesSSE2(out + 16, blendSSE2(broadcast, select[1], fore[1], back[1]), tail - 16);
+            }
+        }
+    }
+} // expandSSE2
+#endif
+
+#if TRANSPOSE_ARM_NEON
+/**
+ * @brief NEON, the bitmap byte broadcast and tested against the selectors, 16 pixel bytes per step
+ */
+static void expandNEON(const uint8_t *rows, uint16_t row_bytes, uint16_t width, uint8_t height, uint8_t y_scale,
+                       uint8_t pixel_bytes, const uint8_t *selector, const uint8_t *foreground,
+                       const uint8_t *background, uint8_t *pixels, uint16_t stride)
+{
+    uint8_t bytes = 8 * pixel_bytes;
+    uint16_t whole = width / 8;
+    uint8_t tail = (width % 8) * pixel_bytes;
+    auto load = [&](const uint8_t *pattern, uint8_t lane) { // Lane of 8 pixels of pattern, zero beyond
+        if (!pattern || (16 * lane) >= bytes)
+            return vdupq_n_u8(0);
+        if (bytes - (16 * lane) == 8)
+            return vcombine_u8(vld1_u8(pattern + (16 * lane)), vdup_n_u8(0));
+        return vld1q_u8(pattern + (16 * lane));
+    };
+    uint8x16_t select[2] = {load(selector, 0), load(selector, 1)};
+    uint8x16_t fore[2] = {load(foreground, 0), load(foreground, 1)};
+    uint8x16_t back[2] = {load(background, 0), load(background, 1)};
+
+    auto expand = [&](uint8_t byte, uint8_t *out) {
+        uint8x16_t broadcast = vdupq_n_u8(byte);
+        uint8x16_t low = vbslq_u8(vtstq_u8(broadcast, select[0]), fore[0],
+                                  background ? back[0] : (bytes == 8) ? vcombine_u8(vld1_u8(out), vdup_n_u8(0)) : vld1q_u8(out));
+        if (bytes == 8)
+            vst1_u8(out, vget_low_u8(low));
+        else
+            vst1q_u8(out, low);
+        if (bytes == 24)
+            vst1_u8(out + 16, vbsl_u8(vtst_u8(vget_low_u8(broadcast), vget_low_u8(select[1])), vget_low_u8(fore[1]),
+                                      background ? vget_low_u8(back[1]) : vld1_u8(out + 16)));
+    };
+
+    for (uint8_t row = 0; row < height; row++)
+    {
+        const uint8_t *bits = rows + (row_bytes * row);
+        for (uint8_t repeat = 0; repeat < y_scale; repeat++)
+        {
+            uint8_t *out = pixels + ((size_t)stride * ((row * y_scale) + repeat));
+            for (uint16_t b = 0; b < whole; b++, out += bytes)
+            {
+                expand(bits[b], out);
+            }
+            if (tail && !background)
+                expandForeground(bits[whole], tail, selector, foreground, out);
+            else if (tail)
+            {
+                uint8_t last[2 * 16];
+                expand(bits[whole], last);
+                copyPixels(out, last, tail);
+            }
+        }
+    }
+} // expandNEON
+#endif
+
+static const pixel_expand_t EXPANDERS[TRANSPOSE_KERNELS] = {
+    expandScalar,
+    expandSWAR,
+#if TRANSPOSE_X86
+    expandSSE2,
+    expandSSE2,
+#else
+    nullptr,
+    nullptr,
+#endif
+#if TRANSPOSE_ARM_NEON
+    expandNEON,
+#else
+    nullptr,
+#endif
+};
+
+/**
+ * @brief Expands L-R bitmap rows into rows of color pixels, foreground for set bits
+ *
+ * Each bitmap byte becomes 8 pixels at once in the instruction set of the
+ * active transpose kernel, its bits compared with a selector for every pixel
+ * byte to give a byte mask that blends the foreground and background. A last
+ * part byte is expanded aside and its pixels moved into the row.
+ *
+ * @param rows the bitmap rows, MSB first
+ * @param row_bytes the bytes from one bitmap row to the next
+ * @param width the row width in pixels
+ * @param height the number of bitmap rows
+ * @param y_scale the times to expand each bitmap row
+ * @param pixel_bytes the bytes of a pixel, 1 to MAX_PIXEL_BYTES
+ * @param foreground the foreground pixel repeated 8 times
+ * @param background the background pixel repeated 8 times, nullptr to leave background pixels as they are
+ * @param pixels the first pixel of the first row
+ * @param stride the bytes from one pixel row to the next
+ */
+void ExpandPixels(const uint8_t *rows, uint16_t row_bytes, uint16_t width, uint8_t height, uint8_t y_scale, uint8_t pixel_bytes,
+                  const uint8_t *foreground, const uint8_t *background, uint8_t *pixels, uint16_t stride)
+{
+    if (!width || !height)
+        return;
+
+    EXPANDERS[active_kernel](rows, row_bytes, width, height, y_scale, pixel_bytes, SELECTORS.selector[pixel_bytes - 1],
+                             foreground, background, pixels, stride);
+} // ExpandPixels
+
+/**
+ * @brief Box filters L-R bitmap rows down into packed gray pixels
+ *
+ * Each gray pixel is the share of set pixels in its factor by factor box of the
+ * bitmap, rounded to the gray levels, boxes past the bitmap's right and bottom
+ * edges counting the missing pixels as clear. Pixels are packed MSB first, the
+ * leftmost in the high bits of each byte, and start phase pixels into the row.
+ *
+ * @param rows the bitmap rows, MSB first
+ * @param row_bytes the bytes from one bitmap row to the next
+ * @param width the row width in pixels
+ * @param height the number of bitmap rows
+ * @param factor the box width and height, 1 to MAX_DOWNSAMPLE
+ * @param bits the bits of a gray pixel, 2 or 4
+ * @param phase the gray pixels before the first in each row, less than 8 / bits
+ * @param gray the gray rows, each written whole
+ * @param gray_bytes the bytes of each gray row
+ */
+void ShrinkRows(const uint8_t *rows, uint16_t row_bytes, uint8_t width, uint8_t height, uint8_t factor, uint8_t bits, uint8_t phase,
+                uint8_t *gray, uint16_t gray_bytes)
+{
+    uint8_t levels = (1 << bits) - 1;
+    uint16_t area = factor * factor;
+    uint8_t gray_width = (width + factor - 1) / factor;
+    uint8_t gray_height = (height + factor - 1) / factor;
+
+    for (uint8_t gy = 0; gy < gray_height; gy++, gray += gray_bytes)
+    {
+        memset(gray, 0, gray_bytes);
+        uint8_t box_rows = std::min<uint8_t>(factor, height - (gy * factor));
+        const uint8_t *top = rows + ((size_t)row_bytes * gy * factor);
+
+        for (uint8_t gx = 0; gx < gray_width; gx++)
+        {
+            uint16_t bit = gx * factor; // First bitmap column of the box
+            uint8_t box_columns = std::min<uint16_t>(factor, width - bit);
+            uint16_t mask = (0xFFFF << (16 - box_columns)) & 0xFFFF; // The box columns, from the top of a 16 bit window
+            uint8_t count = 0;
+            for (uint8_t row = 0; row < box_rows; row++)
+            {
+                const uint8_t *byte = top + ((size_t)row_bytes * row) + (bit / 8);
+                uint16_t window = (byte[0] << 8) | (((bit / 8) + 1 < row_bytes) ? byte[1] : 0);
+                count += __builtin_popcount((window << (bit % 8)) & mask);
+            }
+
+            uint8_t level = ((count * levels) + (area / 2)) / area;
+            uint16_t pixel = (phase + gx) * bits;
+            gray[pixel / 8] |= level << (8 - bits - (pixel % 8));
+        }
+    }
+} // ShrinkRows
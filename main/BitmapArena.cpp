@@ -0,0 +1,218 @@
+/*
+ Raster-Font Library Bitmap Arena
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include "BitmapArena.h"
+
+/**
+ * @brief Instantiates an arena over a caller owned buffer
+ *
+ * @param buffer the arena memory, e.g. a static array
+ * @param bytes the size of the buffer
+ * @param upstream the resource to fall back on when the arena is full
+ */
+FrameArena::FrameArena(void *buffer, size_t bytes, std::pmr::memory_resource *upstream)
+    : m_buffer{static_cast<uint8_t *>(buffer)}, m_owned{false}, m_upstream{upstream}
+{
+    m_stats.capacity = bytes;
+} // FrameArena
+
+/**
+ * @brief Instantiates an arena with a buffer allocated from upstream
+ *
+ * @param bytes the size of the arena
+ * @param upstream the resource for the buffer and to fall back on when the arena is full
+ */
+FrameArena::FrameArena(size_t bytes, std::pmr::memory_resource *upstream)
+    : m_buffer{static_cast<uint8_t *>(upstream->allocate(bytes, alignof(max_align_t)))}, m_owned{true}, m_upstream{upstream}
+{
+    m_stats.capacity = bytes;
+} // FrameArena
+
+FrameArena::~FrameArena()
+{
+    if (m_owned)
+    {
+        m_upstream->deallocate(m_buffer, m_stats.capacity, alignof(max_align_t));
+    }
+} // ~FrameArena
+
+/**
+ * @brief Releases everything allocated from the arena for the next frame
+ */
+void FrameArena::Reset()
+{
+    m_top = 0;
+    m_stats.used = 0;
+    m_stats.resets++;
+} // Reset
+
+/**
+ * @brief The arena statistics, in bytes
+ *
+ * @return the statistics
+ */
+const ArenaStats &FrameArena::Stats() const
+{
+    return m_stats;
+} // Stats
+
+void *FrameArena::do_allocate(size_t bytes, size_t alignment)
+{
+    uintptr_t top = reinterpret_cast<uintptr_t>(m_buffer) + m_top;
+    size_t start = m_top + (((top + alignment - 1) & ~(uintptr_t)(alignment - 1)) - top); // Aligned address, not offset
+
+    if (start > m_stats.capacity || bytes > m_stats.capacity - start)
+    /*
+     * Does not fit, fall back upstream
+     */
+    {
+        m_stats.overflows++;
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    m_top = start + bytes;
+    m_stats.used = m_top;
+    m_stats.allocations++;
+    if (m_stats.used > m_stats.high_water)
+        m_stats.high_water = m_stats.used;
+    return m_buffer + start;
+} // do_allocate
+
+void FrameArena::do_deallocate(void *p, size_t bytes, size_t alignment)
+{
+    uint8_t *bp = static_cast<uint8_t *>(p);
+
+    if (bp < m_buffer || bp >= m_buffer + m_stats.capacity)
+    /*
+     * Overflow allocation
+     */
+    {
+        m_upstream->deallocate(p, bytes, alignment);
+    }
+    else if (bp + bytes == m_buffer + m_top)
+    /*
+     * Most recent allocation, give it back
+     */
+    {
+        m_top = bp - m_buffer;
+        m_stats.used = m_top;
+    }
+} // do_deallocate
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+} // do_is_equal
+
+/**
+ * @brief Instantiates a pool of equal sized blocks allocated from upstream
+ *
+ * @param blockBytes the size of each block
+ * @param blocks the number of blocks
+ * @param upstream the resource for the pool and to fall back on when the pool is exhausted
+ */
+BlockPool::BlockPool(size_t blockBytes, size_t blocks, std::pmr::memory_resource *upstream)
+    : m_block_bytes{((blockBytes + sizeof(void *) - 1) / sizeof(void *)) * sizeof(void *)}, m_upstream{upstream}
+{
+    if (!m_block_bytes)
+        m_block_bytes = sizeof(void *);
+    m_stats.capacity = blocks;
+    m_buffer = static_cast<uint8_t *>(m_upstream->allocate(m_block_bytes * blocks, alignof(max_align_t)));
+
+    for (size_t i = blocks; i > 0; i--)
+    /*
+     * Thread the free list through the blocks, first block at the head
+     */
+    {
+        void *block = m_buffer + (i - 1) * m_block_bytes;
+        *static_cast<void **>(block) = m_free;
+        m_free = block;
+    }
+} // BlockPool
+
+BlockPool::~BlockPool()
+{
+    m_upstream->deallocate(m_buffer, m_block_bytes * m_stats.capacity, alignof(max_align_t));
+} // ~BlockPool
+
+/**
+ * @brief The usable size of each block
+ *
+ * @return bytes per block
+ */
+size_t BlockPool::BlockBytes() const
+{
+    return m_block_bytes;
+} // BlockBytes
+
+/**
+ * @brief The pool statistics, in blocks
+ *
+ * @return the statistics
+ */
+const ArenaStats &BlockPool::Stats() const
+{
+    return m_stats;
+} // Stats
+
+/**
+ * @brief Is the pointer a block of the pool
+ */
+bool BlockPool::Owns(const void *p) const
+{
+    const uint8_t *bp = static_cast<const uint8_t *>(p);
+    return bp >= m_buffer && bp < m_buffer + m_block_bytes * m_stats.capacity;
+} // Owns
+
+void *BlockPool::do_allocate(size_t bytes, size_t alignment)
+{
+    if (bytes > m_block_bytes || alignment > alignof(void *) || !m_free)
+    /*
+     * Does not fit a block, fall back upstream
+     */
+    {
+        m_stats.overflows++;
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    void *block = m_free;
+    m_free = *static_cast<void **>(block);
+    m_stats.used++;
+    m_stats.allocations++;
+    if (m_stats.used > m_stats.high_water)
+        m_stats.high_water = m_stats.used;
+    return block;
+} // do_allocate
+
+void BlockPool::do_deallocate(void *p, size_t bytes, size_t alignment)
+{
+    if (!Owns(p))
+    {
+        m_upstream->deallocate(p, bytes, alignment);
+        return;
+    }
+
+    *static_cast<void **>(p) = m_free;
+    m_free = p;
+    m_stats.used--;
+} // do_deallocate
+
+bool BlockPool::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+} // do_is_equal
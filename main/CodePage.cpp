@@ -0,0 +1,374 @@
+/*
+ Raster-Font Library Code Page
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "CodePage.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define CODEPAGE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define CODEPAGE_ARM_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define HIGH_BITS 0x8080808080808080ULL ///< The top bit of each byte of a word
+
+/**
+ * @brief Code points of KOI8-R bytes 0x80 to 0xFF
+ */
+static constexpr uint16_t KOI8_R[128] = {
+    0x2500, 0x2502, 0x250C, 0x2510, 0x2514, 0x2518, 0x251C, 0x2524,
+    0x252C, 0x2534, 0x253C, 0x2580, 0x2584, 0x2588, 0x258C, 0x2590,
+    0x2591, 0x2592, 0x2593, 0x2320, 0x25A0, 0x2219, 0x221A, 0x2248,
+    0x2264, 0x2265, 0x00A0, 0x2321, 0x00B0, 0x00B2, 0x00B7, 0x00F7,
+    0x2550, 0x2551, 0x2552, 0x0451, 0x2553, 0x2554, 0x2555, 0x2556,
+    0x2557, 0x2558, 0x2559, 0x255A, 0x255B, 0x255C, 0x255D, 0x255E,
+    0x255F, 0x2560, 0x2561, 0x0401, 0x2562, 0x2563, 0x2564, 0x2565,
+    0x2566, 0x2567, 0x2568, 0x2569, 0x256A, 0x256B, 0x256C, 0x00A9,
+    0x044E, 0x0430, 0x0431, 0x0446, 0x0434, 0x0435, 0x0444, 0x0433,
+    0x0445, 0x0438, 0x0439, 0x043A, 0x043B, 0x043C, 0x043D, 0x043E,
+    0x043F, 0x044F, 0x0440, 0x0441, 0x0442, 0x0443, 0x0436, 0x0432,
+    0x044C, 0x044B, 0x0437, 0x0448, 0x044D, 0x0449, 0x0447, 0x044A,
+    0x042E, 0x0410, 0x0411, 0x0426, 0x0414, 0x0415, 0x0424, 0x0413,
+    0x0425, 0x0418, 0x0419, 0x041A, 0x041B, 0x041C, 0x041D, 0x041E,
+    0x041F, 0x042F, 0x0420, 0x0421, 0x0422, 0x0423, 0x0416, 0x0412,
+    0x042C, 0x042B, 0x0417, 0x0428, 0x042D, 0x0429, 0x0427, 0x042A,
+};
+
+/**
+ * @brief A code point and the byte encoding it
+ */
+struct CodeByte
+{
+    uint16_t code;
+    uint8_t byte;
+};
+
+/**
+ * @brief The upper half of a code page sorted by code point, for binary search
+ */
+struct ReverseTable
+{
+    CodeByte entries[128];
+};
+
+/**
+ * @brief Sorts the upper half of a code page by code point at compile time
+ */
+static constexpr ReverseTable reverseOf(const uint16_t (&forward)[128])
+{
+    ReverseTable table{};
+    for (int i = 0; i < 128; i++)
+    /*
+     * Insertion sort
+     */
+    {
+        CodeByte entry{forward[i], (uint8_t)(0x80 + i)};
+        int j = i;
+        for (; j > 0 && table.entries[j - 1].code > entry.code; j--)
+        {
+            table.entries[j] = table.entries[j - 1];
+        }
+        table.entries[j] = entry;
+    }
+    return table;
+} // reverseOf
+
+static constexpr ReverseTable KOI8_R_REVERSE = reverseOf(KOI8_R); ///< KOI8-R bytes by code point
+
+/**
+ * @brief The code page of a font from the character set its name ends with
+ *
+ * @param font_name the font name, such as terminus_8x14_koi8_r
+ * @return the code page, ASCII for fonts naming no other
+ */
+CodePage CodePageOf(const char *font_name)
+{
+    std::string_view name(font_name ? font_name : "");
+    for (int page = CODEPAGE_ISO8859_1; page < CODEPAGES; page++)
+    {
+        std::string_view suffix = CodePageName((CodePage)page);
+        if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0 &&
+            name[name.size() - suffix.size() - 1] == '_')
+            return (CodePage)page;
+    }
+    return CODEPAGE_ASCII;
+} // CodePageOf
+
+/**
+ * @brief The name of a code page, as font names end
+ *
+ * @param page the code page
+ * @return the name
+ */
+const char *CodePageName(CodePage page)
+{
+    switch (page)
+    {
+    case CODEPAGE_ISO8859_1:
+        return "iso8859_1";
+    case CODEPAGE_KOI8_R:
+        return "koi8_r";
+    default:
+        return "ascii";
+    }
+} // CodePageName
+
+/**
+ * @brief The code point of a byte of a code page
+ *
+ * @param page the code page
+ * @param c the byte
+ * @return the code point, UTF8_REPLACEMENT if the byte is unmapped
+ */
+uint32_t CodePageChar(CodePage page, unsigned char c)
+{
+    if (c < 0x80 || page == CODEPAGE_ISO8859_1)
+        return c;
+    if (page == CODEPAGE_KOI8_R)
+        return KOI8_R[c - 0x80];
+    return UTF8_REPLACEMENT;
+} // CodePageChar
+
+/**
+ * @brief The byte of a code page for a code point
+ *
+ * @param page the code page
+ * @param code the code point
+ * @return the byte, -1 if the code page has no byte for it
+ */
+int CodePageByte(CodePage page, uint32_t code)
+{
+    if (code < 0x80)
+        return code;
+
+    switch (page)
+    {
+    case CODEPAGE_ISO8859_1:
+        return (code < 0x100) ? (int)code : -1;
+    case CODEPAGE_KOI8_R:
+    {
+        const CodeByte *begin = KOI8_R_REVERSE.entries, *end = begin + 128;
+        const CodeByte *found = std::lower_bound(begin, end, code, [](const CodeByte &entry, uint32_t c) { return entry.code < c; });
+        return (found != end && found->code == code) ? found->byte : -1;
+    }
+    default:
+        return -1;
+    }
+} // CodePageByte
+
+/**
+ * @brief The number of ASCII bytes the text starts with
+ *
+ * Checks 16 bytes a step with SSE2 or NEON where available, else 8 bytes a
+ * step in a 64 bit word, the last step overlapping the one before rather than
+ * falling back to bytes, so short strings take one or two steps.
+ *
+ * @param text the text
+ * @param length the bytes of text
+ * @return the length of the leading run of bytes below 0x80
+ */
+size_t AsciiSpan(const char *text, size_t length)
+{
+    size_t i = 0;
+
+#if CODEPAGE_SSE2
+    if (length >= 16)
+    {
+        for (;; i += 16)
+        {
+            i = std::min(i, length - 16);
+            int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i)));
+            if (mask)
+                return i + __builtin_ctz(mask);
+            if (i + 16 == length)
+                return length;
+        }
+    }
+#elif CODEPAGE_ARM_NEON
+    if (length >= 16)
+    {
+        for (;; i += 16)
+        {
+            i = std::min(i, length - 16);
+            if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t *>(text + i))) & 0x80)
+                break;
+            if (i + 16 == length)
+                return length;
+        }
+    }
+#endif
+
+    if (length - i >= 8)
+    {
+        for (;; i += 8)
+        {
+            i = std::min(i, length - 8);
+            uint64_t word;
+            memcpy(&word, text + i, sizeof(word));
+            if (word & HIGH_BITS)
+                break;
+            if (i + 8 == length)
+                return length;
+        }
+    }
+    while (i < length && !(text[i] & 0x80))
+    {
+        i++;
+    }
+    return i;
+} // AsciiSpan
+
+/**
+ * @brief Decodes the UTF-8 code point at a position
+ *
+ * Overlong forms, surrogates, code points beyond U+10FFFF and truncated or
+ * stray bytes decode as UTF8_REPLACEMENT, consuming the bytes of the
+ * malformed sequence up to the first that does not continue it.
+ *
+ * @param str the UTF-8 text
+ * @param pos the position of the code point, advanced past it
+ * @return the code point
+ */
+uint32_t DecodeUtf8(std::string_view str, size_t &pos)
+{
+    unsigned char lead = str[pos++];
+    if (lead < 0x80)
+        return lead;
+
+    int extra;
+    uint32_t code, least;
+    if ((lead & 0xE0) == 0xC0)
+    {
+        extra = 1;
+        code = lead & 0x1F;
+        least = 0x80;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        extra = 2;
+        code = lead & 0x0F;
+        least = 0x800;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        extra = 3;
+        code = lead & 0x07;
+        least = 0x10000;
+    }
+    else
+        return UTF8_REPLACEMENT;
+
+    for (int i = 0; i < extra; i++)
+    {
+        if (pos >= str.size() || (str[pos] & 0xC0) != 0x80)
+            return UTF8_REPLACEMENT;
+        code = (code << 6) | (str[pos++] & 0x3F);
+    }
+    if (code < least || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF))
+        return UTF8_REPLACEMENT;
+    return code;
+} // DecodeUtf8
+
+/**
+ * @brief Appends the UTF-8 encoding of a code point
+ *
+ * @param code the code point
+ * @param out the text to append to
+ */
+void EncodeUtf8(uint32_t code, std::string &out)
+{
+    if (code < 0x80)
+        out += (char)code;
+    else if (code < 0x800)
+    {
+        out += (char)(0xC0 | (code >> 6));
+        out += (char)(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000)
+    {
+        out += (char)(0xE0 | (code >> 12));
+        out += (char)(0x80 | ((code >> 6) & 0x3F));
+        out += (char)(0x80 | (code & 0x3F));
+    }
+    else
+    {
+        out += (char)(0xF0 | (code >> 18));
+        out += (char)(0x80 | ((code >> 12) & 0x3F));
+        out += (char)(0x80 | ((code >> 6) & 0x3F));
+        out += (char)(0x80 | (code & 0x3F));
+    }
+} // EncodeUtf8
+
+/**
+ * @brief Maps UTF-8 text to the bytes of a font
+ *
+ * ASCII runs are copied as they are; other code points become their code page
+ * byte, or the fallback where the code page has none or the font lacks it.
+ * Text that is all ASCII is returned unchanged without copying.
+ *
+ * @param str the UTF-8 text
+ * @param page the code page of the font
+ * @param first the first character of the font
+ * @param last the last character of the font
+ * @param fallback the byte for code points the font cannot show
+ * @param bytes storage for the mapped text
+ * @param starts if given, the position in the text of each byte mapped, left empty when the text is returned unchanged
+ * @return the font bytes, the text itself or a view of bytes
+ */
+std::string_view TranscodeUtf8(std::string_view str, CodePage page, unsigned char first, unsigned char last,
+                               unsigned char fallback, std::string &bytes, std::vector<size_t> *starts)
+{
+    size_t run = AsciiSpan(str.data(), str.size());
+
+    if (starts)
+        starts->clear();
+    if (run == str.size())
+        return str;
+
+    bytes.assign(str.data(), run);
+    size_t pos = 0;
+    while (true)
+    {
+        if (starts)
+        {
+            for (size_t i = 0; i < run; i++)
+            {
+                starts->push_back(pos + i);
+            }
+        }
+        pos += run;
+        if (pos >= str.size())
+            break;
+
+        size_t start = pos;
+        int byte = CodePageByte(page, DecodeUtf8(str, pos));
+        bytes += (char)((byte < first || byte > last) ? fallback : byte);
+        if (starts)
+            starts->push_back(start);
+
+        run = AsciiSpan(str.data() + pos, str.size() - pos);
+        bytes.append(str.data() + pos, run);
+    }
+    return bytes;
+} // TranscodeUtf8
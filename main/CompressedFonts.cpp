@@ -0,0 +1,379 @@
+/*
+ Raster-Font Library Compressed Fonts
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <array>
+#include <string.h>
+
+#include "CompressedFonts.h"
+#include "FontTags.h"
+#include "RawFonts.h"
+
+/**
+ * Define RASTERFONT_COMPRESSED_TABLES, for fonts.c too, when fonts are baked
+ * compressed: the font tables and fonts[] are then defined here, rather than by
+ * fonts.c, and the compressed fonts have no bitmap, so theirs is not linked.
+ */
+#ifndef RASTERFONT_COMPRESSED_TABLES
+#define RASTERFONT_COMPRESSED_TABLES 0
+#endif
+
+namespace
+{
+
+/**
+ * @brief The glyph header bytes of the font, rows above and rows stored in a nibble each for fonts under 16 rows
+ */
+constexpr uint8_t headerBytes(const font_info_t &font)
+{
+    return (font.height < 16) ? 1 : 2;
+} // headerBytes
+
+/**
+ * @brief Bit-packs the glyphs of a font, or sizes them
+ *
+ * Shared by the compile time baking and CompressFont.
+ *
+ * @param font the L-R/T-B font
+ * @param glyphs the packed glyph data, nullptr to only size it
+ * @param offsets the offset of each glyph, nullptr to only size the data
+ * @return the bytes of glyph data, 0 if they cannot be indexed by 16 bit offsets
+ */
+constexpr size_t packGlyphs(const font_info_t &font, uint8_t *glyphs, uint16_t *offsets)
+{
+    size_t size = 0;
+
+    for (size_t c = 0; c < charCount(font); c++)
+    {
+        font_char_desc_t char_desc = font.char_descriptors[c];
+        const uint8_t *char_bitmap = font.bitmap + char_desc.offset;
+        uint8_t row_bytes = 1 + ((char_desc.width - 1) / 8);
+
+        uint8_t top = font.height, bottom = 0; // Rows with ink
+        for (uint8_t row = 0; row < font.height; row++)
+        {
+            for (uint8_t x = 0; x < char_desc.width; x++)
+            {
+                if (char_bitmap[(row * row_bytes) + (x / 8)] & (0x80 >> (x % 8)))
+                {
+                    top = (row < top) ? row : top;
+                    bottom = row + 1;
+                }
+            }
+        }
+        if (top >= bottom)
+            top = bottom = 0;
+
+        if (size > 0xFFFF)
+            return 0;
+        if (offsets)
+            offsets[c] = size;
+        if (glyphs && headerBytes(font) == 1)
+        {
+            glyphs[size] = (top << 4) | (bottom - top);
+        }
+        else if (glyphs)
+        {
+            glyphs[size] = top;
+            glyphs[size + 1] = bottom - top;
+        }
+        size += headerBytes(font);
+
+        size_t bit = 0;
+        for (uint8_t row = top; row < bottom; row++)
+        {
+            for (uint8_t x = 0; x < char_desc.width; x++, bit++)
+            {
+                if (!glyphs)
+                    continue;
+                if (!(bit % 8))
+                    glyphs[size + (bit / 8)] = 0;
+                if (char_bitmap[(row * row_bytes) + (x / 8)] & (0x80 >> (x % 8)))
+                    glyphs[size + (bit / 8)] |= 0x80 >> (bit % 8);
+            }
+        }
+        size += (bit + 7) / 8;
+    }
+    return size;
+} // packGlyphs
+
+/**
+ * @brief Packed glyph data and the offset of each glyph
+ */
+template <size_t Count, size_t Size>
+struct CompressedFont
+{
+    std::array<uint16_t, Count> offsets{};
+    std::array<uint8_t, Size> glyphs{};
+};
+
+/**
+ * @brief Bit-packs every character of the font
+ *
+ * @param font the L-R/T-B font
+ * @return the compressed font
+ */
+template <size_t Count, size_t Size>
+constexpr CompressedFont<Count, Size> compressFont(const font_info_t &font)
+{
+    CompressedFont<Count, Size> compressed{};
+    packGlyphs(font, compressed.glyphs.data(), compressed.offsets.data());
+    return compressed;
+} // compressFont
+
+/**
+ * @brief The compressed glyphs of a font, or nullptr when the font is not baked
+ */
+template <const font_info_t &Font, bool Bake = bakeFont(RASTERFONT_COMPRESSED_FONTS, Font.name)>
+struct Compressed
+{
+    static constexpr const compressed_font_info_t *info = nullptr;
+};
+
+template <const font_info_t &Font>
+struct Compressed<Font, true>
+{
+    static constexpr size_t size = packGlyphs(Font, nullptr, nullptr);
+    static_assert(size, "Compressed glyphs of the font do not fit 16 bit offsets");
+
+    static constexpr CompressedFont<charCount(Font), size> font = compressFont<charCount(Font), size>(Font);
+    static constexpr compressed_font_info_t value = {font.glyphs.data(), font.offsets.data(), size};
+    static constexpr const compressed_font_info_t *info = &value;
+};
+
+/**
+ * @brief The table of a font as linked, without the bitmap when the font is baked compressed
+ *
+ * @param font the font
+ * @return the font table
+ */
+constexpr font_info_t linkedFont(const font_info_t &font)
+{
+    font_info_t linked = font;
+    if (bakeFont(RASTERFONT_COMPRESSED_FONTS, font.name))
+        linked.bitmap = nullptr; // Rasterized from the compressed glyphs
+    return linked;
+} // linkedFont
+
+} // namespace
+
+/**
+ * @brief Bit-packs the glyphs of a font at run time, as baked at compile time
+ *
+ * Call with nullptr data to size the glyph data; offsets take one entry per character.
+ *
+ * @param font the L-R/T-B font
+ * @param glyphs the packed glyph data, nullptr to only size it
+ * @param offsets the offset of each glyph, nullptr to only size the data
+ * @return the bytes of glyph data, 0 if they cannot be indexed by 16 bit offsets
+ */
+size_t CompressFont(const font_info_t *font, uint8_t *glyphs, uint16_t *offsets)
+{
+    return packGlyphs(*font, glyphs, offsets);
+} // CompressFont
+
+/**
+ * @brief Unpacks a glyph into L-R/T-B rows, as they are in the font bitmap
+ *
+ * @param compressed the compressed glyphs
+ * @param font the font the glyphs were compressed from
+ * @param index the character descriptor index
+ * @param rows the rows, the font height of whole bytes wide enough for the character
+ */
+void DecodeGlyph(const compressed_font_info_t *compressed, const font_info_t *font, unsigned char index, uint8_t *rows)
+{
+    uint8_t width = font->char_descriptors[index].width;
+    uint8_t row_bytes = 1 + ((width - 1) / 8);
+    const uint8_t *glyph = compressed->glyphs + compressed->offsets[index];
+    uint8_t above, stored;
+    const uint8_t *bits;
+
+    if (font->height < 16)
+    {
+        above = glyph[0] >> 4;
+        stored = glyph[0] & 0x0F;
+        bits = glyph + 1;
+    }
+    else
+    {
+        above = glyph[0];
+        stored = glyph[1];
+        bits = glyph + 2;
+    }
+
+    memset(rows, 0, above * row_bytes);
+    rows += above * row_bytes;
+
+    if (!(width % 8))
+    /*
+     * Whole byte rows were packed as they were
+     */
+    {
+        memcpy(rows, bits, stored * row_bytes);
+        rows += stored * row_bytes;
+    }
+    else
+    {
+        uint32_t buffer = 0; // Bits read ahead, the next in the low order of have
+        uint8_t have = 0;
+        for (uint8_t row = 0; row < stored; row++)
+        {
+            for (uint8_t column = 0, left = width; column < row_bytes; column++)
+            /*
+             * Take each byte of the row from the buffer, refilling it a byte at a time
+             */
+            {
+                uint8_t take = (left < 8) ? left : 8;
+                if (have < take)
+                {
+                    buffer = (buffer << 8) | *bits++;
+                    have += 8;
+                }
+                have -= take;
+                *rows++ = ((buffer >> have) & (0xFF >> (8 - take))) << (8 - take);
+                left -= take;
+            }
+        }
+    }
+
+    memset(rows, 0, (font->height - above - stored) * row_bytes);
+} // DecodeGlyph
+
+const compressed_font_info_t *compressed_fonts[NUM_FONTS] = {
+    Compressed<raw::_fonts_glcd_5x7_info>::info,
+#ifdef FONTS_ASCII
+    /*
+     * ascii fonts
+     */
+    Compressed<raw::_fonts_bitocra_4x7_ascii_info>::info,
+    Compressed<raw::_fonts_roboto_8pt_ascii_info>::info,
+    Compressed<raw::_fonts_roboto_10pt_ascii_info>::info,
+    Compressed<raw::_font_tahoma_8pt_ascii_info>::info,
+#endif
+#ifdef FONTS_ISO8859
+    /*
+     * iso8859_1 fonts
+     */
+    Compressed<raw::_fonts_bitocra_6x11_iso8859_1_info>::info,
+    Compressed<raw::_fonts_bitocra_7x13_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_6x12_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_8x14_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_10x18_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_11x22_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_12x24_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_14x28_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_16x32_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_bold_8x14_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_bold_10x18_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_bold_11x22_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_bold_12x24_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_bold_14x28_iso8859_1_info>::info,
+    Compressed<raw::_fonts_terminus_bold_16x32_iso8859_1_info>::info,
+#endif
+#ifdef FONTS_KOI8
+    /*
+     * koi8_r fonts
+     */
+    Compressed<raw::_fonts_terminus_6x12_koi8_r_info>::info,
+    Compressed<raw::_fonts_terminus_8x14_koi8_r_info>::info,
+    Compressed<raw::_fonts_terminus_14x28_koi8_r_info>::info,
+    Compressed<raw::_fonts_terminus_16x32_koi8_r_info>::info,
+    Compressed<raw::_fonts_terminus_bold_8x14_koi8_r_info>::info,
+    Compressed<raw::_fonts_terminus_bold_14x28_koi8_r_info>::info,
+    Compressed<raw::_fonts_terminus_bold_16x32_koi8_r_info>::info
+#endif
+};
+
+#if RASTERFONT_COMPRESSED_TABLES
+/*
+ * The font tables in place of those of fonts.c, the compressed fonts without their bitmaps
+ */
+extern "C" {
+const font_info_t _fonts_glcd_5x7_info = linkedFont(raw::_fonts_glcd_5x7_info);
+const font_info_t _fonts_bitocra_4x7_ascii_info = linkedFont(raw::_fonts_bitocra_4x7_ascii_info);
+const font_info_t _fonts_roboto_8pt_ascii_info = linkedFont(raw::_fonts_roboto_8pt_ascii_info);
+const font_info_t _fonts_roboto_10pt_ascii_info = linkedFont(raw::_fonts_roboto_10pt_ascii_info);
+const font_info_t _font_tahoma_8pt_ascii_info = linkedFont(raw::_font_tahoma_8pt_ascii_info);
+const font_info_t _fonts_bitocra_6x11_iso8859_1_info = linkedFont(raw::_fonts_bitocra_6x11_iso8859_1_info);
+const font_info_t _fonts_bitocra_7x13_iso8859_1_info = linkedFont(raw::_fonts_bitocra_7x13_iso8859_1_info);
+const font_info_t _fonts_terminus_6x12_iso8859_1_info = linkedFont(raw::_fonts_terminus_6x12_iso8859_1_info);
+const font_info_t _fonts_terminus_8x14_iso8859_1_info = linkedFont(raw::_fonts_terminus_8x14_iso8859_1_info);
+const font_info_t _fonts_terminus_10x18_iso8859_1_info = linkedFont(raw::_fonts_terminus_10x18_iso8859_1_info);
+const font_info_t _fonts_terminus_11x22_iso8859_1_info = linkedFont(raw::_fonts_terminus_11x22_iso8859_1_info);
+const font_info_t _fonts_terminus_12x24_iso8859_1_info = linkedFont(raw::_fonts_terminus_12x24_iso8859_1_info);
+const font_info_t _fonts_terminus_14x28_iso8859_1_info = linkedFont(raw::_fonts_terminus_14x28_iso8859_1_info);
+const font_info_t _fonts_terminus_16x32_iso8859_1_info = linkedFont(raw::_fonts_terminus_16x32_iso8859_1_info);
+const font_info_t _fonts_terminus_bold_8x14_iso8859_1_info = linkedFont(raw::_fonts_terminus_bold_8x14_iso8859_1_info);
+const font_info_t _fonts_terminus_bold_10x18_iso8859_1_info = linkedFont(raw::_fonts_terminus_bold_10x18_iso8859_1_info);
+const font_info_t _fonts_terminus_bold_11x22_iso8859_1_info = linkedFont(raw::_fonts_terminus_bold_11x22_iso8859_1_info);
+const font_info_t _fonts_terminus_bold_12x24_iso8859_1_info = linkedFont(raw::_fonts_terminus_bold_12x24_iso8859_1_info);
+const font_info_t _fonts_terminus_bold_14x28_iso8859_1_info = linkedFont(raw::_fonts_terminus_bold_14x28_iso8859_1_info);
+const font_info_t _fonts_terminus_bold_16x32_iso8859_1_info = linkedFont(raw::_fonts_terminus_bold_16x32_iso8859_1_info);
+const font_info_t _fonts_terminus_6x12_koi8_r_info = linkedFont(raw::_fonts_terminus_6x12_koi8_r_info);
+const font_info_t _fonts_terminus_8x14_koi8_r_info = linkedFont(raw::_fonts_terminus_8x14_koi8_r_info);
+const font_info_t _fonts_terminus_14x28_koi8_r_info = linkedFont(raw::_fonts_terminus_14x28_koi8_r_info);
+const font_info_t _fonts_terminus_16x32_koi8_r_info = linkedFont(raw::_fonts_terminus_16x32_koi8_r_info);
+const font_info_t _fonts_terminus_bold_8x14_koi8_r_info = linkedFont(raw::_fonts_terminus_bold_8x14_koi8_r_info);
+const font_info_t _fonts_terminus_bold_14x28_koi8_r_info = linkedFont(raw::_fonts_terminus_bold_14x28_koi8_r_info);
+const font_info_t _fonts_terminus_bold_16x32_koi8_r_info = linkedFont(raw::_fonts_terminus_bold_16x32_koi8_r_info);
+}
+
+const font_info_t *fonts[NUM_FONTS] = {
+    &_fonts_glcd_5x7_info,
+#ifdef FONTS_ASCII
+    /*
+     * ascii fonts
+     */
+    &_fonts_bitocra_4x7_ascii_info,
+    &_fonts_roboto_8pt_ascii_info,
+    &_fonts_roboto_10pt_ascii_info,
+    &_font_tahoma_8pt_ascii_info,
+#endif
+#ifdef FONTS_ISO8859
+    /*
+     * iso8859_1 fonts
+     */
+    &_fonts_bitocra_6x11_iso8859_1_info,
+    &_fonts_bitocra_7x13_iso8859_1_info,
+    &_fonts_terminus_6x12_iso8859_1_info,
+    &_fonts_terminus_8x14_iso8859_1_info,
+    &_fonts_terminus_10x18_iso8859_1_info,
+    &_fonts_terminus_11x22_iso8859_1_info,
+    &_fonts_terminus_12x24_iso8859_1_info,
+    &_fonts_terminus_14x28_iso8859_1_info,
+    &_fonts_terminus_16x32_iso8859_1_info,
+    &_fonts_terminus_bold_8x14_iso8859_1_info,
+    &_fonts_terminus_bold_10x18_iso8859_1_info,
+    &_fonts_terminus_bold_11x22_iso8859_1_info,
+    &_fonts_terminus_bold_12x24_iso8859_1_info,
+    &_fonts_terminus_bold_14x28_iso8859_1_info,
+    &_fonts_terminus_bold_16x32_iso8859_1_info,
+#endif
+#ifdef FONTS_KOI8
+    /*
+     * koi8_r fonts
+     */
+    &_fonts_terminus_6x12_koi8_r_info,
+    &_fonts_terminus_8x14_koi8_r_info,
+    &_fonts_terminus_14x28_koi8_r_info,
+    &_fonts_terminus_16x32_koi8_r_info,
+    &_fonts_terminus_bold_8x14_koi8_r_info,
+    &_fonts_terminus_bold_14x28_koi8_r_info,
+    &_fonts_terminus_bold_16x32_koi8_r_info
+#endif
+};
+#endif
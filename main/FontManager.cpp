@@ -16,9 +16,13 @@
  See the License for the specific language governing permissions and limitations under the License.
  */
 
-#include "FontManager.h"
+#include <algorithm>
+#include <chrono>
 
-static const uint8_t MSBITS[8] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01}; ///< Segment bit mask
+#include "FontManager.h"
+#include "BitTranspose.h"
+#include "Instrument.h"
+#include "StaticFontManager.h"
 
 /**
  * @brief Instantiates a FontManager for the given font and raster orientation
@@ -26,11 +30,219 @@ static const uint8_t MSBITS[8] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01
  * @param fontindex the font to produce
  * @param raster The direction to rasterize the font
  */
-FontManager::FontManager(uint8_t fontIndex, Raster raster, Orientation orientation) : m_raster{raster}, m_orientation{orientation}
+FontManager::FontManager(uint8_t fontIndex, Raster raster, Orientation orientation)
+    : FontManager(fonts[fontIndex], raster, orientation, paged_fonts[fontIndex], compressed_fonts[fontIndex], FontEngineFor(fontIndex, raster)) // Err out if out of bounds
+{
+} // FontManager
+
+/**
+ * @brief Instantiates a FontManager for a font that is not compiled in, such as one from a FontPack
+ *
+ * The font is referenced, not copied, for the life of the font manager. Strings
+ * are rasterized by the generic character path.
+ *
+ * @param font the font to produce
+ * @param raster The direction to rasterize the font
+ */
+FontManager::FontManager(const font_info_t &font, Raster raster, Orientation orientation)
+    : FontManager(&font, raster, orientation, nullptr, nullptr, nullptr)
+{
+} // FontManager
+
+/**
+ * @brief Instantiates a FontManager for a wide font, its characters by Unicode code point
+ *
+ * The font is referenced, not copied, for the life of the font manager. Strings
+ * are UTF-8 and rasterized by the generic character path, without the glyph cache.
+ *
+ * @param font the font to produce
+ * @param raster The direction to rasterize the font
+ */
+FontManager::FontManager(const wide_font_info_t &font, Raster raster, Orientation orientation)
+    : FontManager(&font.info, raster, orientation, nullptr, nullptr, nullptr)
+{
+    m_wide = &font;
+    if (!WideIndex(font.default_code, m_wide_fallback) && !WideIndex(' ', m_wide_fallback))
+        m_wide_fallback = 0;
+#if RASTERFONT_GLYPH_CACHE
+    m_glyph_cache_enabled = false;
+#endif
+} // FontManager
+
+/**
+ * @brief Instantiates a FontManager for a subset font, taking the character codes of the original font
+ *
+ * The font is referenced, not copied, for the life of the font manager. Codes
+ * dropped from the subset show as the original font's replacement, space or its
+ * first character, where kept. Strings are rasterized by the generic character path.
+ *
+ * @param font the font to produce
+ * @param raster The direction to rasterize the font
+ */
+FontManager::FontManager(const subset_font_info_t &font, Raster raster, Orientation orientation)
+    : FontManager(&font.info, raster, orientation, nullptr, nullptr, nullptr)
+{
+    if (!font.remap)
+        return;
+
+    m_subset = &font;
+    m_first = font.code_start;
+    m_last = font.code_end;
+    m_fallback = (' ' < m_first) ? m_first : (unsigned char)' ';
+    m_subset_replacement = (m_fallback <= m_last) ? font.remap[m_fallback - m_first] : SUBSET_NO_CHAR;
+    if (m_subset_replacement == SUBSET_NO_CHAR)
+        m_subset_replacement = 0;
+} // FontManager
+
+/**
+ * @brief Instantiates a FontManager over a font and its baked forms
+ *
+ * @param font the font to produce
+ * @param raster The direction to rasterize the font
+ * @param paged the baked paged raster of the font, if any
+ * @param compressed the baked compressed glyphs of the font, if any
+ * @param engine the font specialized string entry points, if any
+ */
+FontManager::FontManager(const font_info_t *font, Raster raster, Orientation orientation,
+                         const paged_font_info_t *paged, const compressed_font_info_t *compressed, const FontEngine *engine)
+    : m_font{font}, m_paged{paged}, m_compressed{compressed}, m_raster{raster}, m_orientation{orientation}, m_engine{engine},
+      m_codepage{CodePageOf(font->name)}, m_fallback{(' ' < font->char_start) ? font->char_start : (unsigned char)' '},
+      m_first{font->char_start}, m_last{font->char_end}
 {
-    m_font = fonts[fontIndex]; // Err out if out of bounds
+    if (m_compressed)
+    {
+        uint8_t widest = 0;
+        for (unsigned int c = 0; c <= (unsigned int)(m_font->char_end - m_font->char_start); c++)
+        {
+            widest = std::max(widest, m_font->char_descriptors[c].width);
+        }
+        m_glyph_rows.resize(m_font->height * (1 + ((widest - 1) / 8)));
+    }
+
+    if (m_orientation & 1)
+    {
+        m_rotated_rows.resize(255 * (1 + ((m_font->height - 1) / 8))); // Rows of the widest possible character
+    }
+    else if (m_orientation == B)
+    {
+        m_rotated_rows.resize(m_font->height * 32);
+    }
+
+    Colors(0xFFFFFF, 0); // White on black, the highest index on index 0
 } // FontManager
 
+#if RASTERFONT_GLYPH_CACHE
+/**
+ * @brief Switch the PTBLR and gray glyph cache on or off
+ *
+ * The cache holds each character used so far transposed into page columns for
+ * every height offset, or box filtered into gray rows for every pixel offset
+ * within a byte, so PTBLR and gray rasterization become a copy of cached bytes
+ * and each character is filtered once. Switching the cache off releases the
+ * memory it holds.
+ *
+ * @param enable true to rasterize from the cache
+ */
+void FontManager::GlyphCache(bool enable)
+{
+    m_glyph_cache_enabled = enable && !m_wide; // Wide fonts are too large to cache every character
+    if (!enable)
+    {
+        std::vector<std::vector<uint8_t>>().swap(m_glyph_cache);
+    }
+} // GlyphCache
+
+/**
+ * @brief The memory held by the glyph cache
+ *
+ * @return bytes allocated to the glyph cache
+ */
+size_t FontManager::GlyphCacheBytes()
+{
+    size_t bytes = m_glyph_cache.capacity() * sizeof(std::vector<uint8_t>);
+    for (const std::vector<uint8_t> &glyph : m_glyph_cache)
+    {
+        bytes += glyph.capacity();
+    }
+    return bytes;
+} // GlyphCacheBytes
+#endif
+
+/**
+ * @brief Instantiates an empty bitmap
+ *
+ * @param memory the memory resource to allocate data from
+ */
+FontManager::Bitmap::Bitmap(std::pmr::memory_resource *memory) : resource{memory}
+{
+} // Bitmap
+
+/**
+ * @brief Moves a bitmap, taking ownership of its data
+ *
+ * @param other the bitmap to move, left empty
+ */
+FontManager::Bitmap::Bitmap(Bitmap &&other) noexcept : BitmapView(other), resource{other.resource}
+{
+    other.data = nullptr;
+    other.size = 0;
+} // Bitmap
+
+/**
+ * @brief Move assigns a bitmap, releasing any data held and taking ownership of the other's
+ *
+ * @param other the bitmap to move, left empty
+ * @return this bitmap
+ */
+FontManager::Bitmap &FontManager::Bitmap::operator=(Bitmap &&other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        static_cast<BitmapView &>(*this) = other;
+        resource = other.resource;
+        other.data = nullptr;
+        other.size = 0;
+    }
+    return *this;
+} // operator=
+
+FontManager::Bitmap::~Bitmap()
+{
+    Release();
+} // ~Bitmap
+
+/**
+ * @brief Allocates zeroed data from the memory resource, releasing any held
+ *
+ * @param bytes the size of the data
+ */
+void FontManager::Bitmap::Allocate(size_t bytes)
+{
+    Release();
+    if (bytes)
+    {
+        INSTRUMENT_COUNT(COUNT_BITMAPS, 1);
+        INSTRUMENT_COUNT(COUNT_BYTES_ALLOCATED, bytes);
+        data = static_cast<uint8_t *>(resource->allocate(bytes, 1));
+        memset(data, 0, bytes);
+        size = bytes;
+    }
+} // Allocate
+
+/**
+ * @brief Returns the data to the memory resource
+ */
+void FontManager::Bitmap::Release()
+{
+    if (data)
+    {
+        resource->deallocate(data, size, 1);
+    }
+    data = nullptr;
+    size = 0;
+} // Release
+
 /**
  * @brief The number of fonts available
  * 
@@ -71,310 +283,1399 @@ const char *FontManager::FontName()
 /**
  * @brief   Get the height of current selected font
  * 
- * @return  Height of the font (in pixels) or 0 if none font selected
+ * @return  Height of the font (in pixels), scaled, or 0 if none font selected
  */
 uint8_t FontManager::FontHeight()
 {
-    return (m_font->height);
+    return ((m_font->height * m_scale_y) + m_shrink - 1) / m_shrink;
 } // FontHeight
 
 /**
  * @brief   Get the "C" value (space between adjacent characters)
  * 
- * @return  "C" value
+ * @return  "C" value, scaled, or downsampled to the nearest pixel
  */
 uint8_t FontManager::FontC()
 {
-    return (m_font->c);
+    return ((m_font->c * m_scale_x) + (m_shrink / 2)) / m_shrink;
 } // FontC
 
 /**
- * @brief   Measure width of string with current selected font
+ * @brief   Scale the characters by whole pixels, each font pixel becoming a block of pixels
  * 
- * @param   str String to measure
- * @return  Width of the string
+ * Widths, heights and "C" spacing are scaled as the bitmaps, so measuring,
+ * breaking and the layouts over the font manager follow the scale, which is
+ * to be set before they are made. Scaled strings are rasterized a character
+ * at a time, the bits spread as each character is placed; position offsets
+ * are not scaled.
+ * 
+ * @param   x_scale the times to repeat each column, 1 to MAX_SCALE
+ * @param   y_scale the times to repeat each row, 1 to MAX_SCALE
+ * @return  false if a factor is out of range, a scaled character would exceed 255 pixels or the
+ *          characters are downsampled, the scale being unchanged
  */
-FontManager::XY FontManager::MeasureString(std::string str)
+bool FontManager::Scale(uint8_t x_scale, uint8_t y_scale)
 {
-    XY xy;
+    if (m_shrink > 1 || !x_scale || !y_scale || x_scale > MAX_SCALE || y_scale > MAX_SCALE || m_font->height * y_scale > 255 ||
+        m_font->c * x_scale > 255)
+        return false;
+    for (uint32_t c = 0; c < CharCount(); c++)
+    {
+        if (Descriptor(c).width * x_scale > 255)
+            return false;
+    }
 
-    if (str.empty())
-        return xy;
+    m_scale_x = x_scale;
+    m_scale_y = y_scale;
+    m_scaled = (x_scale > 1) || (y_scale > 1);
+    if (m_orientation & 1) // Turned characters are spread down their rows by the y scale
+        m_scaled_rows.assign((y_scale > 1) ? 255 * (1 + ((m_font->height - 1) / 8)) * y_scale : 0, 0);
+    else
+        m_scaled_rows.assign((x_scale > 1) ? m_font->height * 32 * x_scale : 0, 0);
+#if RASTERFONT_GLYPH_CACHE
+    std::vector<std::vector<uint8_t>>().swap(m_glyph_cache); // Cached at the previous scale
+#endif
+    return true;
+} // Scale
 
-    unsigned char c;
+/**
+ * @brief   Downsample the characters of a gray raster by a box filter, antialiasing a larger font
+ * 
+ * Each gray pixel is the share of set pixels in its factor by factor block of
+ * the font, so a 16x32 font downsampled by 2 shows as 8x16 with smoothed edges.
+ * Widths, heights and "C" spacing are divided as the bitmaps, rounding up the
+ * sizes and to the nearest pixel the spacing, and are to be set before any
+ * layout over the font manager is made. Each character is filtered once into
+ * the glyph cache, when it is on.
+ * 
+ * @param   factor the font pixels across and down each gray pixel, 1 to MAX_DOWNSAMPLE
+ * @return  false if the factor is out of range, the raster is not gray or the characters
+ *          are scaled, the factor being unchanged
+ */
+bool FontManager::Downsample(uint8_t factor)
+{
+    if (!factor || factor > MAX_DOWNSAMPLE || !GrayBits(m_raster) || (m_scaled && factor > 1))
+        return false;
 
-    for (std::string::iterator i = str.begin(); i < str.end(); i++)
-    {
-        c = *i;
-        if ((c < m_font->char_start) || (c > m_font->char_end))
-            c = ' ';                // Replace unknown characters with space
-        c = c - m_font->char_start; // c becomes the character index
+    m_shrink = factor;
+#if RASTERFONT_GLYPH_CACHE
+    std::vector<std::vector<uint8_t>>().swap(m_glyph_cache); // Filtered at the previous factor
+#endif
+    return true;
+} // Downsample
 
-        if (m_orientation & 1)
-        /**
-         * Odd - Verticle orientation 
-         */
-        {
-            xy.y_pixels = (xy.y_pixels > m_font->height) ? xy.y_pixels : m_font->height;
-        }
-        else
-        /**
-         * Even - Horizontal orientation 
-         */
-        {
-            xy.x_pixels += m_font->char_descriptors[c].width; // increment the width
-            if (*i)                                           // Add kerning
-                xy.x_pixels += m_font->c;
-        }
-    }
+/**
+ * @brief   Get the raster direction of the bitmaps produced
+ * 
+ * @return  Raster direction
+ */
+FontManager::Raster FontManager::FontRaster()
+{
+    return m_raster;
+} // FontRaster
+
+/**
+ * @brief   Get the orientation of the characters produced
+ * 
+ * @return  Orientation
+ */
+FontManager::Orientation FontManager::FontOrientation()
+{
+    return m_orientation;
+} // FontOrientation
+
+/**
+ * @brief   Is the raster paged, bytes being columns of 8 pixels down a page
+ * 
+ * @param   raster the raster
+ * @return  true for the paged rasters, false for rows of bytes across
+ */
+bool FontManager::PagedRaster(Raster raster)
+{
+    return raster == PTBLR || raster == PTBLR_MSB || raster == PBTLR;
+} // PagedRaster
 
-    if (xy.y_pixels > 0)
+/**
+ * @brief   The bytes of each pixel of a color raster
+ * 
+ * @param   raster the raster
+ * @return  the pixel bytes, 0 for the monochrome rasters
+ */
+uint8_t FontManager::PixelBytes(Raster raster)
+{
+    switch (raster)
     {
-        xy.x_pixels = m_font->char_descriptors->width;
+    case RGB565:
+        return 2;
+    case RGB888:
+        return 3;
+    case INDEXED8:
+        return 1;
+    default:
+        return 0;
     }
-    else if (xy.x_pixels > 0)
+} // PixelBytes
+
+/**
+ * @brief   The bits of each pixel of a gray raster
+ * 
+ * @param   raster the raster
+ * @return  the pixel bits, 0 for the other rasters
+ */
+uint8_t FontManager::GrayBits(Raster raster)
+{
+    switch (raster)
     {
-        xy.y_pixels = m_font->height;
+    case GRAY2:
+        return 2;
+    case GRAY4:
+        return 4;
+    default:
+        return 0;
     }
-
-    return xy;
-} // MeasureString
+} // GrayBits
 
 /**
- * @brief For wrapping text, the set of characters that break at the pixel positions 
+ * @brief   Set the colors of the color rasters
  * 
- * @param str the string to find the character breaks for
- * @param pixels the number of pixels to break the character string at
- * @return std::Vector<uint16_t> the charater positions that abutt the pixel boundry
+ * Colors are given in the form of the raster: a 16 bit RGB565 value, 0xRRGGBB
+ * or a palette index. The bitmap pixels of a transparent background are left
+ * as they are, zero where cleared, so text can be drawn over a picture.
+ * Monochrome rasters ignore the colors.
+ * 
+ * @param   foreground the color of set font pixels, white by default
+ * @param   background the color of clear font pixels and cleared areas, black by default
+ * @param   transparent leave background pixels as they are rather than setting them
  */
-std::vector<uint16_t> FontManager::CharacterBreaks(std::string str, uint16_t pixels)
+void FontManager::Colors(uint32_t foreground, uint32_t background, bool transparent)
 {
-    std::vector<uint16_t> breaking_chars;
-
-    if (((m_orientation & 1) && pixels < m_font->height) || pixels < m_font->char_descriptors->width)
-    // Check pixel width is sane
+    uint8_t bytes = PixelBytes(m_raster);
+    for (uint8_t byte = 0; byte < 8 * bytes; byte++)
     {
-        return breaking_chars;
+        uint8_t shift = 8 * (bytes - 1 - (byte % bytes)); // Most significant byte first
+        m_foreground[byte] = foreground >> shift;
+        m_background[byte] = background >> shift;
     }
+    m_transparent = transparent;
+} // Colors
 
-    if (m_orientation & 1)
-    /**
-     * Odd - Verticle orientation - Height is standard, so use division
-     */
+/**
+ * @brief   Clear the laid out area of a view to the background
+ * 
+ * The area is zeroed for monochrome rasters and transparent backgrounds, and
+ * filled with the background color otherwise.
+ * 
+ * @param   view the laid out view
+ */
+void FontManager::ClearView(BitmapView &view)
+{
+    uint8_t bytes = PixelBytes(view.raster);
+    if (!view.bytes_per_column || !view.bytes_per_row)
+        return;
+
+    if (!bytes || m_transparent)
     {
-        uint16_t chars_per_line = pixels / m_font->height;
-        for (uint16_t i = chars_per_line; i < strlen(str.c_str()); i += chars_per_line)
+        for (uint16_t row = 0; row < view.bytes_per_column; row++)
         {
-            breaking_chars.push_back(i);
+            memset(view.data + (size_t)view.stride * row, 0, view.bytes_per_row);
         }
-        return breaking_chars;
+        return;
     }
 
-    /**
-     * Even - Horizontal orientation, can be variable, so addition
+    uint16_t filled = std::min<uint16_t>(8 * bytes, view.bytes_per_row);
+    memcpy(view.data, m_background, filled);
+    while (filled < view.bytes_per_row)
+    /*
+     * Double the pixels of the first row, then copy it to the others
      */
-
-    uint16_t char_pos{0};
-    uint16_t pixel_pos{0};
-    unsigned char c;
-
-    for (std::string::iterator i = str.begin(); i < str.end(); i++)
     {
-        c = *i;
-        if ((c < m_font->char_start) || (c > m_font->char_end))
-            c = ' ';                // Replace unknown characters with space
-        c = c - m_font->char_start; // c becomes the character index
+        uint16_t copy = std::min<uint16_t>(filled, view.bytes_per_row - filled);
+        memcpy(view.data + filled, view.data, copy);
+        filled += copy;
+    }
+    for (uint16_t row = 1; row < view.bytes_per_column; row++)
+    {
+        memcpy(view.data + (size_t)view.stride * row, view.data, view.bytes_per_row);
+    }
+} // ClearView
 
-        if ((m_font->char_descriptors[c].width + pixel_pos) > pixels)
-        // Char Break
-        {
-            breaking_chars.push_back(char_pos);
-            pixel_pos = 0;
-        }
-        pixel_pos += m_font->char_descriptors[c].width + m_font->c;
-        char_pos++;
+/**
+ * @brief   The page layout TransposeChar writes for a paged raster
+ */
+static PageOrder pageOrder(FontManager::Raster raster)
+{
+    switch (raster)
+    {
+    case FontManager::PTBLR_MSB:
+        return PAGE_MSB_TOP;
+    case FontManager::PBTLR:
+        return PAGE_BOTTOM_UP;
+    default:
+        return PAGE_LSB_TOP;
     }
+} // pageOrder
 
-    return breaking_chars;
-} // CharacterBreaks
+/**
+ * @brief   Get the code page of the font, from its name unless set
+ * 
+ * @return  Code page UTF-8 strings are mapped to
+ */
+CodePage FontManager::FontCodePage()
+{
+    return m_codepage;
+} // FontCodePage
 
 /**
- * @brief Create a Bitmap object
+ * @brief   Set the code page UTF-8 strings are mapped to, for fonts not named by character set
  * 
- * @param r 
- * @param o 
- * @param w 
- * @param h 
- * @param bitOffset 
- * @return FontManager::bitmap 
+ * @param   page the byte encoding of the font
  */
-static FontManager::Bitmap createBitmap(FontManager::Raster r, FontManager::Orientation o, FontManager::XY xy, uint16_t bitOffset)
+void FontManager::FontCodePage(CodePage page)
 {
-    FontManager::Bitmap bm;
-    bm.raster = r;
-    bm.orientation = o;
-    bm.width_pixels = xy.x_pixels;
-    bm.height_pixels = xy.y_pixels;
+    m_codepage = page;
+} // FontCodePage
 
-    switch (r)
-    {
-    case FontManager::LRTB:
-        bm.width_offset_pixels = bitOffset % 8;
-        bm.width_pixels += bm.width_offset_pixels;
-        bm.bytes_per_row = ((bm.width_pixels - 1) / 8) + 1;
-        bm.bytes_per_column = bm.height_pixels; // Bytes
-        bm.bitpoint = bm.width_offset_pixels;  // Bytes
-        break;
-    case FontManager::PTBLR:
-        bm.height_offset_pixels = bitOffset % 8;
-        bm.height_pixels += bm.height_offset_pixels;
-        bm.bytes_per_row = bm.width_pixels;                     // Bytes
-        bm.bytes_per_column = ((bm.height_pixels - 1) / 8) + 1; // Bytes
-        break;
-    }
-    printf("Calloc %d %d %d %d\n", xy.x_pixels, xy.y_pixels, bm.bytes_per_row, bm.bytes_per_column);
-    bm.data = (uint8_t *)calloc(bm.bytes_per_row, bm.bytes_per_column);
-    printf("Calloc done\n");
-    return bm;
-} // createBitmap
+/**
+ * @brief   Switch UTF-8 strings on or off
+ * 
+ * When on, strings given to MeasureString, CharacterBreaks, RequiredBytes and
+ * the Rasterize functions are UTF-8, each code point mapped to its byte in the
+ * font's code page; when off, the default, each byte is a character of the font.
+ * Single characters are always font bytes. Wide fonts always take UTF-8.
+ * 
+ * @param   enable true for UTF-8 strings
+ */
+void FontManager::Utf8(bool enable)
+{
+    m_utf8 = enable;
+} // Utf8
 
 /**
- * @brief Bitmaps a string using the font, shifting the bitmap as required.
- *
- * Raster the string using the font manager settings into a new bitmap structure.
- * The string can be shifted along or down in the bitmap by up to 7 bits -
- * the x or y shift is calculated from modulus 8 of the shift parameters, allowing
- * absolute position to be used without prior calculation from the caller.
- *
- * @param str String to bitmap
- * @param bitoffset The number of bits to shift the bitmap
- * @return Bitmap of the string
+ * @brief   Are strings UTF-8 mapped to the code page
+ * 
+ * @return  true if switched on, false for font bytes and for wide fonts
+ */
+bool FontManager::Utf8()
+{
+    return m_utf8 && !m_wide;
+} // Utf8
+
+/**
+ * @brief   Set the character shown for code points the font cannot show
+ * 
+ * Defaults to the replacement for unknown characters, space or the first
+ * character, or for wide fonts their default character.
+ * 
+ * @param   c the fallback character, a byte of the font or a code point below 256 of a wide font
  */
-FontManager::Bitmap FontManager::Rasterize(std::string str, uint16_t bitOffset)
+void FontManager::Fallback(unsigned char c)
 {
-    Bitmap scan = createBitmap(m_raster, T, MeasureString(str), bitOffset);
+    m_fallback = c;
+    if (m_wide)
+        WideIndex(c, m_wide_fallback);
+} // Fallback
 
-    for (char &c : str)
+/**
+ * @brief   The font bytes of a string, mapped from UTF-8 when switched on
+ * 
+ * For measuring character by character, as with CharWidth. Wide fonts take
+ * UTF-8 as it is.
+ * 
+ * @param   str the string
+ * @param   bytes storage for the mapped string
+ * @param   starts if given, the position in the string of each byte mapped, left empty when the string is used as it is
+ * @return  the string itself if not mapped or all ASCII, else a view of bytes
+ */
+std::string_view FontManager::FontText(std::string_view str, std::string &bytes, std::vector<size_t> *starts)
+{
+    if (m_wide || !m_utf8 || AsciiSpan(str.data(), str.size()) == str.size())
     {
-        if ((c < m_font->char_start) || (c > m_font->char_end))
-            c = ' ';
-        c = c - m_font->char_start;
-        RasterChar(c, scan);
-    };
+        if (starts)
+            starts->clear();
+        return str;
+    }
+    return TranscodeUtf8(str, m_codepage, m_first, m_last, m_fallback, bytes, starts);
+} // FontText
 
-    return scan;
-} // Rasterize
+/**
+ * @brief   Get the width of a character, unknown characters measuring as their replacement
+ * 
+ * @param   c the character
+ * @return  Width of the character in pixels, scaled, without the "C" spacing
+ */
+uint8_t FontManager::CharWidth(unsigned char c)
+{
+    return Width(CharIndex(c));
+} // CharWidth
 
 /**
- * @brief Bitmaps a character using the font, shifting the bitmap as required.
+ * @brief   The descriptor index of a character
  *
- * Raster the character using the font manager settings into a new bitmap structure.
- * The character can be shifted along or down in the bitmap by up to 7 bits -
- * the x or y shift is calculated from modulus 8 of the shift parameters, allowing
- * absolute position to be used without prior calculation from the caller.
+ * Characters outside the font are replaced with space, or with the first
+ * character when the font has no space; those a wide font lacks with its
+ * fallback. Subset fonts remap the original character codes.
  *
- * @param c The character to bitmap
- * @param bitoffset The number of bits to shift the bitmap
- * @return Bitmap of the char
+ * @param   c the character, a code point for wide fonts
+ * @return  index of the character descriptor
  */
-FontManager::Bitmap FontManager::Rasterize(unsigned char c, uint16_t bitOffset)
+uint32_t FontManager::CharIndex(uint32_t c)
 {
+    if (m_wide)
+    {
+        uint32_t index;
+        return WideIndex(c, index) ? index : m_wide_fallback;
+    }
+    if (m_subset)
+    {
+        uint8_t index = ((c >= m_first) && (c <= m_last)) ? m_subset->remap[c - m_first] : SUBSET_NO_CHAR;
+        return (index == SUBSET_NO_CHAR) ? m_subset_replacement : index;
+    }
     if ((c < m_font->char_start) || (c > m_font->char_end))
-        c = ' ';
-    c = c - m_font->char_start;
+        c = (' ' < m_font->char_start) ? m_font->char_start : ' '; // Replace unknown characters
+    return c - m_font->char_start;
+} // CharIndex
+
+/**
+ * @brief   The descriptor index of a code point of the wide font
+ *
+ * The block of the code point gives the index of its first character, to which
+ * are added the characters present before the code point in the block.
+ *
+ * @param   code the code point
+ * @param   index the index of the character descriptor
+ * @return  false if the font has no character for the code point
+ */
+bool FontManager::WideIndex(uint32_t code, uint32_t &index)
+{
+    if ((code >> 8) >= m_wide->block_count)
+        return false;
+    uint16_t block_index = m_wide->block_index[code >> 8];
+    if (block_index == WIDE_NO_BLOCK)
+        return false;
+
+    const wide_char_block_t &block = m_wide->blocks[block_index];
+    uint8_t word = (code & 0xFF) >> 5;
+    uint32_t bit = 1u << (code & 0x1F);
+    if (!(block.present[word] & bit))
+        return false;
+
+    index = block.first + __builtin_popcount(block.present[word] & (bit - 1));
+    for (uint8_t w = 0; w < word; w++)
+    {
+        index += __builtin_popcount(block.present[w]);
+    }
+    return true;
+} // WideIndex
+
+/**
+ * @brief   The number of character descriptors of the font
+ *
+ * @return  the character count
+ */
+uint32_t FontManager::CharCount()
+{
+    return m_wide ? m_wide->char_count : (uint32_t)(m_font->char_end - m_font->char_start + 1);
+} // CharCount
+
+/**
+ * @brief   The descriptor of a character, of either font kind
+ *
+ * @param   c the character index
+ * @return  the character width and bitmap offset
+ */
+wide_char_desc_t FontManager::Descriptor(uint32_t c)
+{
+    if (m_wide)
+        return m_wide->char_descriptors[c];
+    font_char_desc_t char_desc = m_font->char_descriptors[c];
+    return {char_desc.offset, char_desc.width};
+} // Descriptor
+
+/**
+ * @brief   The scaled or downsampled width of a character
+ *
+ * @param   c the character index
+ * @return  the width in pixels
+ */
+uint8_t FontManager::Width(uint32_t c)
+{
+    return ((Descriptor(c).width * m_scale_x) + m_shrink - 1) / m_shrink;
+} // Width
+
+/**
+ * @brief   Visits the characters of font text
+ *
+ * Font text is bytes of the font, or UTF-8 for wide fonts.
+ *
+ * @param   text the font text
+ * @param   visit called with the index, the character or code point, and the
+ *          position in the text of each character
+ */
+template <typename Visit>
+void FontManager::ForEachChar(std::string_view text, Visit visit)
+{
+    if (m_wide)
+    {
+        for (size_t pos = 0; pos < text.size();)
+        {
+            size_t start = pos;
+            uint32_t code = DecodeUtf8(text, pos);
+            visit(CharIndex(code), code, start);
+        }
+        return;
+    }
+    for (size_t pos = 0; pos < text.size(); pos++)
+    {
+        unsigned char c = text[pos];
+        visit(CharIndex(c), c, pos);
+    }
+} // ForEachChar
+
+/**
+ * @brief   The L-R/T-B bitmap of a character, decompressed if the font is compressed
+ *
+ * @param   c the character index
+ * @return  the character rows, valid until the next character is decompressed
+ */
+const uint8_t *FontManager::CharBitmap(uint32_t c)
+{
+    if (m_compressed)
+    {
+        DecodeGlyph(m_compressed, m_font, c, m_glyph_rows.data());
+        return m_glyph_rows.data();
+    }
+    return m_font->bitmap + Descriptor(c).offset;
+} // CharBitmap
+
+/**
+ * @brief   The L-R/T-B bitmap of a character turned to the orientation
+ *
+ * Right and left orientations turn the character a quarter turn, so its
+ * rows are its columns, top to bottom for right and bottom to top for left.
+ *
+ * @param   c the character index
+ * @return  the turned rows, valid until the next character is turned
+ */
+const uint8_t *FontManager::OrientedBitmap(uint32_t c)
+{
+    if (m_orientation == T)
+        return CharBitmap(c);
+
+    RotateChar(CharBitmap(c), Descriptor(c).width, m_font->height, m_orientation, m_rotated_rows.data());
+    return m_rotated_rows.data();
+} // OrientedBitmap
+
+/**
+ * @brief   Measure width of string with current selected font
+ * 
+ * @param   str String to measure, UTF-8 if switched on
+ * @return  Width of the string
+ */
+FontManager::XY FontManager::MeasureString(std::string_view str)
+{
+    return MeasureText(FontText(str, m_text));
+} // MeasureString
+
+/**
+ * @brief Measure width of font bytes
+ * 
+ * @param str the bytes to measure
+ * @return Width of the bytes
+ */
+FontManager::XY FontManager::MeasureText(std::string_view str)
+{
+    INSTRUMENT_LATENCY(TIME_MEASURE_STRING);
 
     XY xy;
 
+    if (m_engine && !m_scaled)
+    /**
+     * Measured horizontally by the font specialized engine
+     */
+    {
+        xy = m_engine->measure_string(str);
+    }
+    else if (!str.empty())
+    {
+        ForEachChar(str, [&](uint32_t c, uint32_t code, size_t) {
+            xy.x_pixels += Width(c); // increment the width
+            if (code)                // Add kerning
+                xy.x_pixels += FontC();
+        });
+
+        if (xy.x_pixels > 0)
+        {
+            xy.y_pixels = FontHeight();
+        }
+    }
+
     if (m_orientation & 1)
+    /**
+     * Odd - Verticle orientation, the horizontal text turned a quarter
+     */
     {
-        xy = {m_font->height, m_font->char_descriptors[c].width};
+        std::swap(xy.x_pixels, xy.y_pixels);
     }
-    else
+
+    return xy;
+} // MeasureText
+
+/**
+ * @brief For wrapping text, the set of characters that break at the pixel positions 
+ * 
+ * UTF-8 strings break between code points, at byte positions of the string.
+ * Pixels are along the text, down the bitmap for verticle orientations.
+ * 
+ * @param str the string to find the character breaks for
+ * @param pixels the number of pixels to break the character string at
+ * @return std::Vector<uint16_t> the charater positions that abutt the pixel boundry
+ */
+std::vector<uint16_t> FontManager::CharacterBreaks(std::string_view str, uint16_t pixels)
+{
+    INSTRUMENT_LATENCY(TIME_CHARACTER_BREAKS);
+
+    std::vector<uint16_t> breaking_chars;
+
+    if (pixels < Width(0))
+    // Check pixel width is sane
     {
-        xy = {m_font->char_descriptors[c].width, m_font->height};
+        return breaking_chars;
     }
 
-    printf("rasterize scan\n");
+    std::vector<size_t> starts; // UTF-8 position of each font byte, empty if the same
+    str = FontText(str, m_text, &starts);
+
+    uint16_t pixel_pos{0};
+
+    ForEachChar(str, [&](uint32_t c, uint32_t, size_t char_pos) {
+        uint8_t width = Width(c);
+        if ((width + pixel_pos) > pixels)
+        // Char Break
+        {
+            breaking_chars.push_back(starts.empty() ? char_pos : starts[char_pos]);
+            pixel_pos = 0;
+        }
+        pixel_pos += width + FontC();
+    });
+
+    return breaking_chars;
+} // CharacterBreaks
+
+/**
+ * @brief Lays out a bitmap for the raster, dimensions and offset
+ * 
+ * The bit-point starts at the start of the text: the left for the top
+ * orientation, the top for right, the right for bottom and the bottom for left,
+ * placing characters along the bitmap width, or down its height for verticle
+ * orientations, from there.
+ * 
+ * @param bm the bitmap to lay out, a zero stride becoming bytes_per_row
+ * @param r the raster
+ * @param o the orientation
+ * @param xy the pixel dimensions of the content
+ * @param bitOffset the position offset, modulus 8, or the gray pixels of a byte
+ */
+static void layoutBitmap(FontManager::BitmapView &bm, FontManager::Raster r, FontManager::Orientation o, FontManager::XY xy, uint16_t bitOffset)
+{
+    bm.raster = r;
+    bm.orientation = o;
+    bm.width_pixels = xy.x_pixels;
+    bm.height_pixels = xy.y_pixels;
+    bm.width_offset_pixels = 0;
+    bm.height_offset_pixels = 0;
+    bm.bitpoint = 0;
+
+    switch (r)
+    {
+    case FontManager::LRTB:
+    case FontManager::LRTB_LSB:
+        bm.width_offset_pixels = bitOffset % 8;
+        bm.width_pixels += bm.width_offset_pixels;
+        bm.bytes_per_row = ((bm.width_pixels - 1) / 8) + 1;
+        bm.bytes_per_column = bm.height_pixels; // Bytes
+        bm.bitpoint = bm.width_offset_pixels;  // Bytes
+        break;
+    case FontManager::PTBLR:
+    case FontManager::PTBLR_MSB:
+    case FontManager::PBTLR:
+        bm.height_offset_pixels = bitOffset % 8;
+        bm.height_pixels += bm.height_offset_pixels;
+        bm.bytes_per_row = bm.width_pixels;                     // Bytes
+        bm.bytes_per_column = ((bm.height_pixels - 1) / 8) + 1; // Bytes
+        break;
+    case FontManager::RGB565:
+    case FontManager::RGB888:
+    case FontManager::INDEXED8:
+        bm.bytes_per_row = bm.width_pixels * FontManager::PixelBytes(r); // Whole pixels, no position offset
+        bm.bytes_per_column = bm.height_pixels;
+        break;
+    case FontManager::GRAY2:
+    case FontManager::GRAY4:
+    {
+        uint8_t bits = FontManager::GrayBits(r);
+        bm.width_offset_pixels = bitOffset % (8 / bits); // Whole pixels within the first byte
+        bm.width_pixels += bm.width_offset_pixels;
+        bm.bytes_per_row = ((bm.width_pixels * bits) + 7) / 8;
+        bm.bytes_per_column = bm.height_pixels;
+        bm.bitpoint = bm.width_offset_pixels;
+        break;
+    }
+    }
+
+    switch (o)
+    {
+    case FontManager::B:
+        bm.bitpoint += xy.x_pixels; // Right of the text
+        break;
+    case FontManager::R:
+        bm.bitpoint = 0; // Top of the text
+        break;
+    case FontManager::L:
+        bm.bitpoint = xy.y_pixels; // Bottom of the text
+        break;
+    default:
+        break;
+    }
+
+    if (!bm.stride)
+        bm.stride = bm.bytes_per_row;
+} // layoutBitmap
+
+/**
+ * @brief The bytes spanned by a laid out bitmap
+ * 
+ * @param bm the bitmap
+ * @return the span from the first byte of the first row to the last byte of the last row
+ */
+static size_t bitmapBytes(const FontManager::BitmapView &bm)
+{
+    if (!bm.bytes_per_column || !bm.bytes_per_row)
+        return 0;
+    return (size_t)bm.stride * (bm.bytes_per_column - 1) + bm.bytes_per_row;
+} // bitmapBytes
+
+/**
+ * @brief Create a Bitmap object
+ * 
+ * @param r 
+ * @param o 
+ * @param w 
+ * @param h 
+ * @param bitOffset 
+ * @param resource the memory resource to allocate the bitmap data from
+ * @return FontManager::bitmap 
+ */
+static FontManager::Bitmap createBitmap(FontManager::Raster r, FontManager::Orientation o, FontManager::XY xy, uint16_t bitOffset,
+                                        std::pmr::memory_resource *resource)
+{
+    FontManager::Bitmap bm(resource);
+    layoutBitmap(bm, r, o, xy, bitOffset);
+    bm.clear = false;
+    bm.Allocate(bitmapBytes(bm));
+    return bm;
+} // createBitmap
+
+/**
+ * @brief The dimensions of a single character
+ * 
+ * @param c the character index
+ * @return the character dimensions
+ */
+FontManager::XY FontManager::MeasureChar(uint32_t c)
+{
+    if (m_orientation & 1)
+    {
+        return {FontHeight(), Width(c)};
+    }
+    return {Width(c), FontHeight()};
+} // MeasureChar
+
+/**
+ * @brief Lays out a caller owned bitmap and checks the data fits it
+ * 
+ * @param view the bitmap
+ * @param raster the raster direction
+ * @param xy the pixel dimensions of the content
+ * @param bitOffset the position offset
+ * @param orientation the text orientation, where the bit-point starts
+ * @return true if the view can take the content and has been cleared as requested
+ */
+bool FontManager::PrepareView(BitmapView &view, Raster raster, XY xy, uint16_t bitOffset, Orientation orientation)
+{
+    uint16_t stride = view.stride;
+    layoutBitmap(view, raster, orientation, xy, bitOffset);
+    size_t bytes = bitmapBytes(view);
+
+    if ((stride && stride < view.bytes_per_row) || bytes > view.size || (bytes && !view.data))
+        return false;
+
+    if (view.clear)
+    {
+        for (uint16_t row = 0; row < view.bytes_per_column; row++)
+        {
+            memset(view.data + (size_t)view.stride * row, 0, view.bytes_per_row);
+        }
+    }
+    return true;
+} // PrepareView
+
+/**
+ * @brief The buffer size needed to rasterize a string
+ * 
+ * @param str the string
+ * @param bitOffset the position offset
+ * @param stride the bytes between rows or pages, 0 for tightly packed
+ * @return the bytes a BitmapView needs for RasterizeInto, 0 if the stride is too small
+ */
+size_t FontManager::RequiredBytes(std::string_view str, uint16_t bitOffset, uint16_t stride)
+{
+    BitmapView view;
+    view.stride = stride;
+    layoutBitmap(view, m_raster, m_orientation, MeasureText(FontText(str, m_text)), bitOffset);
+    return (view.stride < view.bytes_per_row) ? 0 : bitmapBytes(view);
+} // RequiredBytes
+
+/**
+ * @brief The buffer size needed to rasterize a character
+ * 
+ * @param c the character
+ * @param bitOffset the position offset
+ * @param stride the bytes between rows or pages, 0 for tightly packed
+ * @return the bytes a BitmapView needs for RasterizeInto, 0 if the stride is too small
+ */
+size_t FontManager::RequiredBytes(unsigned char c, uint16_t bitOffset, uint16_t stride)
+{
+    BitmapView view;
+    view.stride = stride;
+    layoutBitmap(view, m_raster, m_orientation, MeasureChar(CharIndex(c)), bitOffset);
+    return (view.stride < view.bytes_per_row) ? 0 : bitmapBytes(view);
+} // RequiredBytes
+
+/**
+ * @brief The largest single character bitmap of the font
+ * 
+ * Sizes fixed blocks, such as a BlockPool, to hold any Rasterize(unsigned char) result.
+ * 
+ * @return the bytes of the largest character bitmap at any position offset
+ */
+size_t FontManager::MaxCharBytes()
+{
+    size_t max_bytes = 0;
+    for (uint32_t c = 0; c < CharCount(); c++)
+    {
+        for (uint16_t bitOffset = 0; bitOffset < 8; bitOffset++)
+        {
+            BitmapView view;
+            layoutBitmap(view, m_raster, m_orientation, MeasureChar(c), bitOffset);
+            max_bytes = std::max(max_bytes, bitmapBytes(view));
+        }
+    }
+    return max_bytes;
+} // MaxCharBytes
+
+/**
+ * @brief Bitmaps a string into a caller owned buffer, shifting the bitmap as required.
+ *
+ * The view supplies data, size and stride, and whether to clear the area or OR
+ * into it, e.g. directly into a display buffer; the layout fields are filled in.
+ * Nothing is allocated.
+ *
+ * @param str String to bitmap
+ * @param view The bitmap to raster into
+ * @param bitoffset The number of bits to shift the bitmap
+ * @return false if the buffer is too small or the stride too narrow, nothing being written
+ */
+bool FontManager::RasterizeInto(std::string_view str, BitmapView &view, uint16_t bitOffset)
+{
+    INSTRUMENT_LATENCY(TIME_RASTERIZE_INTO);
+
+    std::string_view text = FontText(str, m_text);
+
+    if (!PrepareView(view, m_raster, MeasureText(text), bitOffset, m_orientation))
+        return false;
+    if (view.clear && PixelBytes(m_raster) && !m_transparent)
+        ClearView(view);
+
+    RasterString(text, view);
+
+    INSTRUMENT_COUNT(COUNT_GLYPHS, text.size());
+    return true;
+} // RasterizeInto
+
+/**
+ * @brief Bitmaps a character into a caller owned buffer, shifting the bitmap as required.
+ *
+ * @param c The character to bitmap
+ * @param view The bitmap to raster into
+ * @param bitoffset The number of bits to shift the bitmap
+ * @return false if the buffer is too small or the stride too narrow, nothing being written
+ */
+bool FontManager::RasterizeInto(unsigned char c, BitmapView &view, uint16_t bitOffset)
+{
+    INSTRUMENT_LATENCY(TIME_RASTERIZE_INTO);
+
+    uint32_t index = CharIndex(c);
+
+    if (!PrepareView(view, m_raster, MeasureChar(index), bitOffset, m_orientation))
+        return false;
+    if (view.clear && PixelBytes(m_raster) && !m_transparent)
+        ClearView(view);
+
+    RasterChar(index, view);
+    INSTRUMENT_COUNT(COUNT_GLYPHS, 1);
+    return true;
+} // RasterizeInto
 
-    Bitmap scan = createBitmap(m_raster, T, xy, bitOffset);
+/**
+ * @brief Bitmaps a string using the font, shifting the bitmap as required.
+ *
+ * Raster the string using the font manager settings into a new bitmap structure.
+ * The string can be shifted along or down in the bitmap by up to 7 bits -
+ * the x or y shift is calculated from modulus 8 of the shift parameters, allowing
+ * absolute position to be used without prior calculation from the caller.
+ *
+ * @param str String to bitmap
+ * @param bitoffset The number of bits to shift the bitmap
+ * @param resource The memory resource to allocate the bitmap from
+ * @return Bitmap of the string
+ */
+FontManager::Bitmap FontManager::Rasterize(std::string_view str, uint16_t bitOffset, std::pmr::memory_resource *resource)
+{
+    INSTRUMENT_LATENCY(TIME_RASTERIZE_STRING);
 
-    printf("rasterize raster\n");
-    RasterChar(c, scan);
-    printf("rasterize done\n");
+    std::string_view text = FontText(str, m_text);
+    INSTRUMENT_COUNT(COUNT_GLYPHS, text.size());
+
+    Bitmap scan = createBitmap(m_raster, m_orientation, MeasureText(text), bitOffset, resource);
+    if (PixelBytes(m_raster) && !m_transparent)
+        ClearView(scan);
+
+    RasterString(text, scan);
+
+    return scan;
+} // Rasterize
+
+/**
+ * @brief Bitmaps a character using the font, shifting the bitmap as required.
+ *
+ * Raster the character using the font manager settings into a new bitmap structure.
+ * The character can be shifted along or down in the bitmap by up to 7 bits -
+ * the x or y shift is calculated from modulus 8 of the shift parameters, allowing
+ * absolute position to be used without prior calculation from the caller.
+ *
+ * @param c The character to bitmap
+ * @param bitoffset The number of bits to shift the bitmap
+ * @param resource The memory resource to allocate the bitmap from
+ * @return Bitmap of the char
+ */
+FontManager::Bitmap FontManager::Rasterize(unsigned char c, uint16_t bitOffset, std::pmr::memory_resource *resource)
+{
+    INSTRUMENT_LATENCY(TIME_RASTERIZE_CHAR);
+    INSTRUMENT_COUNT(COUNT_GLYPHS, 1);
+
+    uint32_t index = CharIndex(c);
+
+    Bitmap scan = createBitmap(m_raster, m_orientation, MeasureChar(index), bitOffset, resource);
+    if (PixelBytes(m_raster) && !m_transparent)
+        ClearView(scan);
+
+    RasterChar(index, scan);
     return scan;
 } // Rasterize
 
+/**
+ * @brief Bitmaps a batch of strings into one contiguous block
+ *
+ * @param items the strings and their position offsets
+ * @param count the number of items
+ * @param resource The memory resource to allocate the batch from
+ * @return the bitmaps of the strings, in order
+ */
+FontManager::BitmapBatch FontManager::RasterizeBatch(const BatchItem *items, size_t count, std::pmr::memory_resource *resource)
+{
+    BitmapBatch batch(resource);
+    RasterizeBatch(items, count, batch);
+    return batch;
+} // RasterizeBatch
+
+/**
+ * @brief Bitmaps a batch of strings into one contiguous block, reusing the batch storage
+ *
+ * All strings are measured and laid out first, then the block is sized once
+ * and the strings rasterized back to back into it. UTF-8 strings are mapped
+ * once, into the batch, and rasterized from there.
+ *
+ * @param items the strings and their position offsets
+ * @param count the number of items
+ * @param batch the batch to rasterize into, its previous bitmaps being replaced
+ */
+void FontManager::RasterizeBatch(const BatchItem *items, size_t count, BitmapBatch &batch)
+{
+    INSTRUMENT_LATENCY(TIME_RASTERIZE_BATCH);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    batch.stats = BatchStats();
+    batch.index.resize(count);
+    batch.texts.resize(count);
+    batch.text.clear();
+    if (Utf8())
+    /*
+     * Room for every item mapped, so the text is never moved and the views stay valid
+     */
+    {
+        size_t bytes = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            bytes += items[i].str.size();
+        }
+        batch.text.reserve(bytes);
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++)
+    /*
+     * Map, measure and lay out every item, data offsets accumulating into the block
+     */
+    {
+        BitmapView &view = batch.index[i];
+        std::string_view text = FontText(items[i].str, m_text);
+        if (text.data() != items[i].str.data())
+        {
+            size_t at = batch.text.size();
+            batch.text.append(text.data(), text.size());
+            text = std::string_view(batch.text).substr(at);
+        }
+        batch.texts[i] = text;
+        view = BitmapView();
+        layoutBitmap(view, m_raster, m_orientation, MeasureText(text), items[i].bitOffset);
+        view.size = bitmapBytes(view);
+        view.clear = false;
+        total += view.size;
+        batch.stats.glyphs += text.size();
+    }
+
+    std::chrono::steady_clock::time_point measured = std::chrono::steady_clock::now();
+
+    batch.block.assign(total, 0);
+    uint8_t *data = batch.block.data();
+    for (size_t i = 0; i < count; i++)
+    {
+        BitmapView &view = batch.index[i];
+        view.data = view.size ? data : nullptr;
+        data += view.size;
+        if (view.data && PixelBytes(m_raster) && !m_transparent)
+            ClearView(view);
+
+        RasterString(batch.texts[i], view);
+    }
+
+    std::chrono::steady_clock::time_point done = std::chrono::steady_clock::now();
+
+    INSTRUMENT_COUNT(COUNT_GLYPHS, batch.stats.glyphs);
+    INSTRUMENT_COUNT(COUNT_BYTES_ALLOCATED, total);
+
+    batch.stats.items = count;
+    batch.stats.bytes = total;
+    batch.stats.measure_us = std::chrono::duration_cast<std::chrono::microseconds>(measured - start).count();
+    batch.stats.rasterize_us = std::chrono::duration_cast<std::chrono::microseconds>(done - measured).count();
+} // RasterizeBatch
+
+/**
+ * @brief The bytes of each row of a gray glyph
+ *
+ * @param bits the bits of a gray pixel
+ * @param phase the pixels the glyph is offset into its first byte
+ * @param width the glyph width in gray pixels
+ * @return the bytes spanned by the offset row
+ */
+static uint16_t grayRowBytes(uint8_t bits, uint8_t phase, uint8_t width)
+{
+    return (((phase + width) * bits) + 7) / 8;
+} // grayRowBytes
+
+#if RASTERFONT_GLYPH_CACHE
+/**
+ * @brief The first byte of each pixel offset phase of a cached gray glyph
+ *
+ * @param bits the bits of a gray pixel
+ * @param width the glyph width in gray pixels
+ * @param height the glyph height in gray pixels
+ * @param offsets the cumulative bytes before each phase, and in all 8 / bits
+ */
+static void grayPhases(uint8_t bits, uint8_t width, uint8_t height, size_t offsets[5])
+{
+    offsets[0] = 0;
+    for (uint8_t phase = 0; phase < 8 / bits; phase++)
+    {
+        offsets[phase + 1] = offsets[phase] + ((size_t)grayRowBytes(bits, phase, width) * height);
+    }
+} // grayPhases
+
+/**
+ * @brief The first page row of each height offset phase of a cached glyph
+ *
+ * @param height the glyph height in pixels
+ * @param rows the cumulative page count before each phase, and in all 8
+ */
+static void phaseRows(uint8_t height, uint16_t rows[9])
+{
+    rows[0] = 0;
+    for (uint8_t phase = 0; phase < 8; phase++)
+    {
+        rows[phase + 1] = rows[phase] + (((height + phase - 1) / 8) + 1);
+    }
+} // phaseRows
+
+/**
+ * @brief The cached PTBLR columns or gray rows for the character, made on first use
+ *
+ * Phases are stored one after the other, each phase being the page rows of
+ * the scaled character, turned to the orientation, its width in columns, in
+ * the page layout of the raster, or for the gray rasters the gray rows of the
+ * turned character offset by each pixel within a byte.
+ *
+ * @param c the character index
+ * @return the cached columns of all 8 phases, or gray rows of all 8 / bits phases
+ */
+const uint8_t *FontManager::CachedGlyph(uint32_t c)
+{
+    if (m_glyph_cache.empty())
+    {
+        m_glyph_cache.resize(CharCount());
+    }
+
+    std::vector<uint8_t> &glyph = m_glyph_cache[c];
+    if (glyph.empty())
+    {
+        INSTRUMENT_COUNT(COUNT_CACHE_MISSES, 1);
+        bool vertical = m_orientation & 1;
+        uint8_t glyph_width = vertical ? m_font->height : Descriptor(c).width;
+        uint8_t glyph_height = vertical ? Descriptor(c).width : m_font->height;
+        uint8_t scale_x = vertical ? m_scale_y : m_scale_x;
+        uint8_t scale_y = vertical ? m_scale_x : m_scale_y;
+        uint8_t columns = glyph_width * scale_x;
+
+        if (uint8_t bits = GrayBits(m_raster))
+        /*
+         * Filter the character once for each pixel phase
+         */
+        {
+            size_t offsets[5];
+            grayPhases(bits, (columns + m_shrink - 1) / m_shrink, (glyph_height + m_shrink - 1) / m_shrink, offsets);
+            glyph.resize(offsets[8 / bits] + 1); // Never empty, even for zero width characters
+            for (uint8_t phase = 0; phase < 8 / bits; phase++)
+            {
+                ShrinkChar(c, phase, glyph.data() + offsets[phase]);
+            }
+            return glyph.data();
+        }
+
+        uint16_t rows[9];
+        phaseRows(glyph_height * scale_y, rows);
+
+        const uint8_t *char_bitmap = OrientedBitmap(c);
+        glyph.resize(columns * rows[8] + 1); // Never empty, even for zero width characters
+        for (uint8_t phase = 0; phase < 8; phase++)
+        {
+            TransposeScaledChar(char_bitmap, glyph_width, glyph_height, scale_x, scale_y, phase,
+                                glyph.data() + columns * rows[phase], columns, pageOrder(m_raster));
+        }
+    }
+    else
+    {
+        INSTRUMENT_COUNT(COUNT_CACHE_HITS, 1);
+    }
+    return glyph.data();
+} // CachedGlyph
+#endif
+
+/**
+ * @brief Box filters a character, turned to the orientation and scaled across, into gray rows
+ *
+ * @param c the character index
+ * @param phase the gray pixels the character is offset into the first byte of each row
+ * @param gray the gray rows, each spanning the offset character
+ */
+void FontManager::ShrinkChar(uint32_t c, uint8_t phase, uint8_t *gray)
+{
+    bool vertical = m_orientation & 1;
+    uint8_t glyph_width = vertical ? m_font->height : Descriptor(c).width;
+    uint8_t glyph_height = vertical ? Descriptor(c).width : m_font->height;
+    uint8_t scale_x = vertical ? m_scale_y : m_scale_x;
+    uint8_t bits = GrayBits(m_raster);
+    const uint8_t *char_bitmap = OrientedBitmap(c);
+    uint16_t read_bytes = 1 + ((glyph_width - 1) / 8);
+
+    if (scale_x > 1)
+    {
+        ScaleRows(char_bitmap, glyph_width, glyph_height, scale_x, m_scaled_rows.data());
+        char_bitmap = m_scaled_rows.data();
+        read_bytes *= scale_x;
+    }
+
+    uint8_t across = glyph_width * scale_x;
+    ShrinkRows(char_bitmap, read_bytes, across, glyph_height, m_shrink, bits, phase, gray,
+               grayRowBytes(bits, phase, (across + m_shrink - 1) / m_shrink));
+} // ShrinkChar
+
+/**
+ * @brief Rasters a string and appends to the bitmap
+ *
+ * Dispatches once to the font and raster specialized engine, except for PTBLR
+ * rasterizing from the glyph cache, which is per font manager, compressed
+ * fonts, which the engines do not read, scaled or turned strings and fonts
+ * that are not compiled in.
+ *
+ * @param str the string to rasterize
+ * @param view the bitmap to append the rasterized string to
+ */
+void FontManager::RasterString(std::string_view str, BitmapView &view)
+{
+    bool per_char = !m_engine || m_compressed || m_scaled || m_orientation != T;
+#if RASTERFONT_GLYPH_CACHE
+    per_char = per_char || (m_raster == PTBLR && !m_paged && m_glyph_cache_enabled);
+#endif
+    if (per_char)
+    {
+        ForEachChar(str, [&](uint32_t c, uint32_t, size_t) { RasterChar(c, view); });
+        return;
+    }
+    m_engine->raster_string(str, view);
+} // RasterString
+
 /**
  * @brief Rasters the given character and appends to the bitmap
  * 
+ * Characters are turned to the orientation, placed at the bit-point along the
+ * text and the bit-point moved on, back for bottom and left orientations whose
+ * text runs right to left and bottom to top. Scaled characters have their rows
+ * spread across the scaled bytes, each row placed once for each scaled row.
+ * LSB first rows and MSB top pages reverse the bits of each byte by table, and
+ * bottom up pages place characters from the bottom of the bitmap.
+ * Color rows expand each byte of the character into 8 pixels of the foreground
+ * and background colors. Gray rows are box filtered from the character, or
+ * read from the glyph cache, and ORed in.
+ * 
  * @param c the character to rasterize
  * @param bm the bitmap to append the rasterized character to
  */
-void FontManager::RasterChar(unsigned char c, Bitmap &bm)
+void FontManager::RasterChar(uint32_t c, BitmapView &bm)
 {
-    font_char_desc_t char_desc = m_font->char_descriptors[c];
-    const uint8_t *char_bitmap = m_font->bitmap + char_desc.offset;  // Pointer to L-R bitmap
-    uint8_t horizontal_read_bytes = 1 + ((char_desc.width - 1) / 8); // Bytes to read for horizontal
-    uint8_t *pixel;                                                  // Data byte placement
-    uint8_t right_shift{0};                                          // The right shift to apply
-    uint8_t column_coefficient{8};                                   // PTBLR default
-    uint8_t row_coefficient{1};                                      // PTBLR default
+    bool vertical = m_orientation & 1;
+    uint8_t width = Width(c);                                                // Scaled width along the text
+    uint8_t glyph_width = vertical ? m_font->height : Descriptor(c).width;   // Turned character width
+    uint8_t glyph_height = vertical ? Descriptor(c).width : m_font->height; // Turned character height
+    uint8_t scale_x = vertical ? m_scale_y : m_scale_x;                     // Scale across the turned character
+    uint8_t scale_y = vertical ? m_scale_x : m_scale_y;                     // Scale down the turned character
+    uint8_t across = glyph_width * scale_x;                                  // Bitmap pixels across the character
 
-    if (bm.raster == LRTB)
+    uint16_t along = bm.bitpoint; // Start of the character along the text
+    if (m_orientation == B || m_orientation == L)
+    /*
+     * Reversed text, each character before the bit-point
+     */
+    {
+        along = (bm.bitpoint > width) ? bm.bitpoint - width : 0;
+        bm.bitpoint = (along > FontC()) ? along - FontC() : 0;
+    }
+    else
     {
-        right_shift = bm.bytes_per_row % 8; // Number of bits to shift right on placement
-        row_coefficient = 1;                // For vertical raster, each row is 1/8th shift
-        row_coefficient = 8;
+        bm.bitpoint += width + FontC(); // Increment pointer to next char
     }
 
-    for (uint8_t row = 0; row < m_font->height; row++)
-    /**
-     * Cycle throught each horizontal scan line of the character 
+    if (!glyph_width || !glyph_height)
+        return;
+
+    uint16_t x = vertical ? bm.width_offset_pixels : along; // Bit (LRTB), column (PTBLR) or pixel (color, gray) of the character left
+    uint16_t y = vertical ? along : 0;                      // Pixel row of the character top
+    if (bm.raster == PBTLR)
+    /*
+     * Pixel row of the character bottom, from the bottom of the bitmap
      */
     {
-        uint16_t row_data_offset = bm.bytes_per_column * ((row + bm.height_offset_pixels) / column_coefficient); //
-        pixel = bm.data + row_data_offset + (bm.bytes_per_row / row_coefficient);                                // address plus rows plus offset
+        y = bm.height_pixels - bm.height_offset_pixels - y - (glyph_height * scale_y);
+    }
+    y += bm.height_offset_pixels;
 
-        for (uint8_t column = 0; column < horizontal_read_bytes; column++)
+    switch (bm.raster)
+    {
+    case LRTB:
+    case LRTB_LSB:
+    {
+        bool lsb = bm.raster == LRTB_LSB;                    // Bits placed reversed, shifting left
+        const uint8_t *char_bitmap = OrientedBitmap(c);     // Pointer to L-R bitmap
+        uint8_t right_shift = x % 8;                         // Number of bits to shift right on placement
+        uint8_t read_bytes = 1 + ((glyph_width - 1) / 8);    // Bytes of each row read
+        uint8_t write_bytes = read_bytes;
+        uint16_t stride = bm.stride;
+        uint8_t *origin = bm.data + ((size_t)stride * y) + (x / 8);
+
+        if (scale_x > 1)
         /*
-         *  Read a horizontal slice of the current character, place it in the scan
+         * Spread every row across its scaled bytes
+         */
+        {
+            ScaleRows(char_bitmap, glyph_width, glyph_height, scale_x, m_scaled_rows.data());
+            char_bitmap = m_scaled_rows.data();
+            read_bytes *= scale_x;
+            write_bytes = 1 + ((across - 1) / 8);
+        }
+
+        for (uint8_t row = 0; row < glyph_height; row++)
+        /**
+         * Cycle throught each horizontal scan line of the character 
          */
         {
-            uint8_t word = *char_bitmap++; // Read the next byte
+            const uint8_t *line = char_bitmap + (read_bytes * row);
+            uint8_t *pixel = origin + ((size_t)stride * row * scale_y); // Row address plus bit-point byte
 
-            switch (bm.raster)
+            for (uint8_t column = 0; column < write_bytes; column++, pixel++)
+            /*
+             * Process the byte into the current location, across byte boundaries if needed,
+             * once for each scaled row
+             */
             {
-            case LRTB:
-                /*
-                * Process the byte into the current location, across byte boundaries if needed
-                */
-                *pixel++ |= (word >> right_shift); // Font char MSBs shifted to end of destination byte
-                if (right_shift)
+                uint8_t word = lsb ? BIT_REVERSE[line[column]] : line[column]; // Read the next byte
+                uint8_t head = lsb ? word << right_shift : word >> right_shift; // Font char MSBs shifted to end of destination byte
+                uint8_t spill = !right_shift ? 0 : lsb ? word >> (8 - right_shift) : word << (8 - right_shift); // Font char LSB shifted to start of next destination byte
+                for (uint32_t repeat = 0; repeat < uint32_t(stride) * scale_y; repeat += stride)
                 {
-                    *pixel |= (word << (8 - right_shift)); // Font char LSB shifted to start of next destination byte
+                    pixel[repeat] |= head;
+                    if (spill)
+                        pixel[repeat + 1] |= spill;
                 }
-                break;
-
-            case PTBLR:
-                /*
-                * Process the bits, each going into a different vertical segment in the same bit position
-                */
-                uint8_t bit_position = (row + bm.height_offset_pixels) % 8; // Vertical in the byte, little endian
-                for (uint8_t seg = (8 * column);
-                     seg <= std::min(static_cast<uint8_t>((column * 8) + 7), char_desc.width); seg++)
-                /*
-                * Bit Cycle through this horizontal byte, each goes to a different segment
-                * Font is Big-Endian, Segment is Little-Endian
-                */
+            }
+        }
+        break;
+    }
+
+    case RGB565:
+    case RGB888:
+    case INDEXED8:
+    {
+        uint8_t pixel_bytes = PixelBytes(bm.raster);
+        const uint8_t *char_bitmap = OrientedBitmap(c);  // Pointer to L-R bitmap
+        uint8_t read_bytes = 1 + ((glyph_width - 1) / 8); // Bytes of each row read
+        const uint8_t *background = m_transparent ? nullptr : m_background;
+        uint8_t *origin = bm.data + ((size_t)bm.stride * y) + ((size_t)x * pixel_bytes);
+
+        if (scale_x > 1)
+        /*
+         * Spread every row across its scaled bytes
+         */
+        {
+            ScaleRows(char_bitmap, glyph_width, glyph_height, scale_x, m_scaled_rows.data());
+            char_bitmap = m_scaled_rows.data();
+            read_bytes *= scale_x;
+        }
+
+        ExpandPixels(char_bitmap, read_bytes, across, glyph_height, scale_y, pixel_bytes, m_foreground, background, origin,
+                     bm.stride);
+        break;
+    }
+
+    case GRAY2:
+    case GRAY4:
+    {
+        uint8_t bits = GrayBits(bm.raster);
+        uint8_t phase = x % (8 / bits);                               // Pixels into the first byte
+        uint8_t gray_width = (across + m_shrink - 1) / m_shrink;       // Gray pixels across the character
+        uint8_t gray_height = (glyph_height + m_shrink - 1) / m_shrink; // Gray rows down the character
+        uint16_t gray_bytes = grayRowBytes(bits, phase, gray_width);
+        uint8_t *origin = bm.data + ((size_t)bm.stride * y) + ((x * bits) / 8);
+        const uint8_t *gray = nullptr;
+
+#if RASTERFONT_GLYPH_CACHE
+        if (m_glyph_cache_enabled)
+        {
+            size_t offsets[5];
+            grayPhases(bits, gray_width, gray_height, offsets);
+            gray = CachedGlyph(c) + offsets[phase];
+        }
+#endif
+        if (!gray)
+        /*
+         * Filter the character for this placement only
+         */
+        {
+            if (m_gray_rows.size() < (size_t)gray_bytes * gray_height)
+                m_gray_rows.resize((size_t)gray_bytes * gray_height);
+            ShrinkChar(c, phase, m_gray_rows.data());
+            gray = m_gray_rows.data();
+        }
+
+        for (uint8_t row = 0; row < gray_height; row++, gray += gray_bytes)
+        /*
+         * OR each gray row into the bitmap, once for each scaled row
+         */
+        {
+            uint8_t *pixel = origin + ((size_t)bm.stride * row * scale_y);
+            for (uint32_t repeat = 0; repeat < uint32_t(bm.stride) * scale_y; repeat += bm.stride)
+            {
+                for (uint16_t byte = 0; byte < gray_bytes; byte++)
+                {
+                    pixel[repeat + byte] |= gray[byte];
+                }
+            }
+        }
+        break;
+    }
+
+    case PTBLR:
+    case PTBLR_MSB:
+    case PBTLR:
+    {
+        uint8_t *pages = bm.data + ((size_t)bm.stride * (y / 8)) + x; // First page of the character
+        uint8_t phase = y % 8;
+
+        if (m_paged && !m_scaled && m_orientation == T && bm.raster == PTBLR)
+        /*
+         * OR the baked page columns into each page, shifted down across pages by the offset
+         */
+        {
+            INSTRUMENT_COUNT(COUNT_PAGED_GLYPHS, 1);
+            uint8_t page_count = ((m_font->height - 1) / 8) + 1;
+            const uint8_t *columns = m_paged->pages + m_paged->offsets[c];
+            for (uint8_t page = 0; page < page_count; page++)
+            {
+                uint8_t *pixel = pages + (bm.stride * page);
+                for (uint8_t seg = 0; seg < across; seg++)
                 {
-                    if (word & MSBITS[seg % 8]) // Font bit is set in this bit position
-                    {
-                        *(pixel + seg) |= (1 << bit_position); // Set bit
-                    }
+                    uint8_t column = *columns++;
+                    pixel[seg] |= column << phase;
+                    if (phase && (column >> (8 - phase)))
+                        pixel[seg + bm.stride] |= column >> (8 - phase);
                 }
-                break;
             }
+            break;
         }
+#if RASTERFONT_GLYPH_CACHE
+        if (m_glyph_cache_enabled)
+        /*
+         * OR the pre-transposed columns for this phase into each page
+         */
+        {
+            uint16_t rows[9];
+            phaseRows(glyph_height * scale_y, rows);
+            const uint8_t *columns = CachedGlyph(c) + across * rows[phase];
+            for (uint16_t page = 0; page < rows[phase + 1] - rows[phase]; page++)
+            {
+                uint8_t *pixel = pages + ((size_t)bm.stride * page);
+                for (uint8_t seg = 0; seg < across; seg++)
+                {
+                    *pixel++ |= *columns++;
+                }
+            }
+            break;
+        }
+#endif
+        if (m_scaled)
+            TransposeScaledChar(OrientedBitmap(c), glyph_width, glyph_height, scale_x, scale_y, phase, pages, bm.stride,
+                                pageOrder(bm.raster));
+        else
+            TransposeChar(OrientedBitmap(c), glyph_width, glyph_height, phase, pages, bm.stride, pageOrder(bm.raster));
+        break;
+    }
     }
-    bm.bytes_per_row += char_desc.width + m_font->c; // Increment pointer to next char
 } // RasterChar
@@ -0,0 +1,454 @@
+/*
+ Raster-Font Library Font Pack
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FONT_PACK_MMAP 1 ///< Packs can be opened from files
+#endif
+
+#include "FontPack.h"
+
+#define FONT_PACK_MAGIC "RFPK" ///< The first four bytes of a pack
+
+static_assert(sizeof(font_pack_header_t) == 32, "Font pack header layout");
+static_assert(sizeof(font_pack_entry_t) == 24, "Font pack directory entry layout");
+static_assert(sizeof(font_char_desc_t) == 4 && offsetof(font_char_desc_t, offset) == 2,
+              "Font pack descriptors are used in place as font_char_desc_t");
+
+/**
+ * @brief Is the host little-endian, as packs are
+ */
+static bool littleEndian()
+{
+    uint16_t probe = 1;
+    return *reinterpret_cast<uint8_t *>(&probe) == 1;
+} // littleEndian
+
+/**
+ * @brief Rounds a pack offset up to the section alignment
+ */
+static size_t aligned(size_t offset)
+{
+    return (offset + FONT_PACK_ALIGN - 1) & ~(size_t)(FONT_PACK_ALIGN - 1);
+} // aligned
+
+FontPack::FontPack()
+{
+} // FontPack
+
+FontPack::~FontPack()
+{
+    Close();
+} // ~FontPack
+
+/**
+ * @brief The bytes of a font's bitmaps, to the end of the furthest character
+ *
+ * @param font the font
+ * @return the bitmap size
+ */
+size_t FontPack::BitmapBytes(const font_info_t *font)
+{
+    size_t bytes = 0;
+    for (unsigned int c = 0; c <= (unsigned int)(font->char_end - font->char_start); c++)
+    {
+        font_char_desc_t char_desc = font->char_descriptors[c];
+        bytes = std::max(bytes, char_desc.offset + ((size_t)font->height * (1 + ((char_desc.width - 1) / 8))));
+    }
+    return bytes;
+} // BitmapBytes
+
+/**
+ * @brief Lays out fonts as a pack in memory
+ *
+ * @param fonts the fonts, compiled in or loaded
+ * @param count the number of fonts
+ * @return the pack, empty if there are too many fonts or one is baked compressed, without a bitmap
+ */
+std::vector<uint8_t> FontPack::Build(const font_info_t *const *fonts, size_t count)
+{
+    std::vector<subset_font_info_t> whole(count);
+    std::vector<const subset_font_info_t *> subsets(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        whole[i].info = *fonts[i];
+        subsets[i] = &whole[i];
+    }
+    return Build(subsets.data(), count);
+} // Build
+
+/**
+ * @brief Lays out fonts, whole or subset, as a pack in memory
+ *
+ * @param fonts the fonts, those without a remap table whole
+ * @param count the number of fonts
+ * @return the pack, empty if there are too many fonts or one is baked compressed, without a bitmap
+ */
+std::vector<uint8_t> FontPack::Build(const subset_font_info_t *const *fonts, size_t count)
+{
+    std::vector<uint8_t> pack;
+    if (count > 0xFFFF)
+        return pack;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!fonts[i]->info.bitmap)
+            return pack;
+    }
+
+    font_pack_header_t header{};
+    std::vector<font_pack_entry_t> entries(count);
+
+    size_t offset = aligned(sizeof(header));
+    header.directory_offset = offset;
+    offset = aligned(offset + (count * sizeof(font_pack_entry_t)));
+
+    for (size_t i = 0; i < count; i++)
+    /*
+     * Place the name, descriptors, bitmaps and any remap table of each font
+     */
+    {
+        const font_info_t *font = &fonts[i]->info;
+        font_pack_entry_t &entry = entries[i];
+
+        entry.height = font->height;
+        entry.c = font->c;
+        entry.char_start = font->char_start;
+        entry.char_end = font->char_end;
+        entry.name_offset = offset;
+        offset = aligned(offset + strlen(font->name) + 1);
+        entry.descriptors_offset = offset;
+        offset = aligned(offset + ((entry.char_end - entry.char_start + 1) * sizeof(font_char_desc_t)));
+        entry.bitmap_offset = offset;
+        entry.bitmap_bytes = BitmapBytes(font);
+        offset = aligned(offset + entry.bitmap_bytes);
+        if (fonts[i]->remap)
+        {
+            entry.remap_offset = offset;
+            offset = aligned(offset + 2 + (fonts[i]->code_end - fonts[i]->code_start + 1));
+        }
+    }
+
+    memcpy(header.magic, FONT_PACK_MAGIC, sizeof(header.magic));
+    header.version = FONT_PACK_VERSION;
+    header.font_count = count;
+    header.pack_bytes = offset;
+
+    pack.assign(offset, 0);
+    memcpy(pack.data(), &header, sizeof(header));
+    memcpy(pack.data() + header.directory_offset, entries.data(), count * sizeof(font_pack_entry_t));
+    for (size_t i = 0; i < count; i++)
+    {
+        const font_info_t *font = &fonts[i]->info;
+        const font_pack_entry_t &entry = entries[i];
+
+        strcpy(reinterpret_cast<char *>(pack.data() + entry.name_offset), font->name);
+        for (unsigned int c = 0; c <= (unsigned int)(entry.char_end - entry.char_start); c++)
+        {
+            font_char_desc_t char_desc{};
+            char_desc.width = font->char_descriptors[c].width;
+            char_desc.offset = font->char_descriptors[c].offset;
+            memcpy(pack.data() + entry.descriptors_offset + (c * sizeof(char_desc)), &char_desc, sizeof(char_desc));
+        }
+        memcpy(pack.data() + entry.bitmap_offset, font->bitmap, entry.bitmap_bytes);
+        if (entry.remap_offset)
+        {
+            pack[entry.remap_offset] = fonts[i]->code_start;
+            pack[entry.remap_offset + 1] = fonts[i]->code_end;
+            memcpy(pack.data() + entry.remap_offset + 2, fonts[i]->remap, fonts[i]->code_end - fonts[i]->code_start + 1);
+        }
+    }
+    return pack;
+} // Build
+
+/**
+ * @brief Writes a pack to a file
+ *
+ * The pack is written to a temporary file beside the target and renamed over
+ * it once complete, so a failed write leaves any existing file as it was.
+ */
+static bool writePack(const char *path, const std::vector<uint8_t> &pack)
+{
+    if (!littleEndian() || pack.empty())
+        return false;
+
+    std::string temporary = std::string(path) + ".tmp";
+    FILE *file = fopen(temporary.c_str(), "wb");
+    if (!file)
+        return false;
+
+    bool written = fwrite(pack.data(), 1, pack.size(), file) == pack.size();
+    written = (fclose(file) == 0) && written;
+    if (written && rename(temporary.c_str(), path) == 0)
+        return true;
+
+    remove(temporary.c_str());
+    return false;
+} // writePack
+
+/**
+ * @brief Writes fonts to a pack file
+ *
+ * @param path the file to write
+ * @param fonts the fonts, compiled in or loaded
+ * @param count the number of fonts
+ * @return false if the pack could not be written
+ */
+bool FontPack::Write(const char *path, const font_info_t *const *fonts, size_t count)
+{
+    return writePack(path, Build(fonts, count));
+} // Write
+
+/**
+ * @brief Writes fonts, whole or subset, to a pack file
+ *
+ * @param path the file to write
+ * @param fonts the fonts, those without a remap table whole
+ * @param count the number of fonts
+ * @return false if the pack could not be written
+ */
+bool FontPack::Write(const char *path, const subset_font_info_t *const *fonts, size_t count)
+{
+    return writePack(path, Build(fonts, count));
+} // Write
+
+/**
+ * @brief Memory maps a pack file
+ *
+ * @param path the pack file
+ * @return false if the file cannot be mapped or is not a pack
+ */
+bool FontPack::Open(const char *path)
+{
+    Close();
+#ifdef FONT_PACK_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return false;
+
+    if (!Attach(map, st.st_size))
+    {
+        munmap(map, st.st_size);
+        return false;
+    }
+    m_map = map;
+    m_map_bytes = st.st_size;
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+} // Open
+
+/**
+ * @brief Uses a pack already in memory, which must outlive the pack and its fonts
+ *
+ * @param data the pack, aligned to FONT_PACK_ALIGN
+ * @param size the bytes available
+ * @return false if the data is not a pack this version reads
+ */
+bool FontPack::Attach(const void *data, size_t size)
+{
+    Close();
+
+    font_pack_header_t header;
+    if (!littleEndian() || !data || size < sizeof(header) || (reinterpret_cast<uintptr_t>(data) % FONT_PACK_ALIGN))
+        return false;
+
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, FONT_PACK_MAGIC, sizeof(header.magic)) || header.version < 1 || header.version > FONT_PACK_VERSION ||
+        header.pack_bytes > size || header.directory_offset % FONT_PACK_ALIGN ||
+        header.directory_offset > header.pack_bytes ||
+        (header.pack_bytes - header.directory_offset) / sizeof(font_pack_entry_t) < header.font_count)
+        return false;
+
+    m_data = static_cast<const uint8_t *>(data);
+    m_size = header.pack_bytes;
+    m_fonts.assign(header.font_count, subset_font_info_t{});
+    return true;
+} // Attach
+
+/**
+ * @brief Releases the pack, its fonts becoming invalid
+ */
+void FontPack::Close()
+{
+#ifdef FONT_PACK_MMAP
+    if (m_map)
+        munmap(m_map, m_map_bytes);
+#endif
+    m_map = nullptr;
+    m_map_bytes = 0;
+    m_data = nullptr;
+    m_size = 0;
+    m_fonts.clear();
+} // Close
+
+/**
+ * @brief The number of fonts in the pack
+ *
+ * @return the font count, 0 if no pack is open
+ */
+uint16_t FontPack::FontCount() const
+{
+    return m_fonts.size();
+} // FontCount
+
+/**
+ * @brief A font of the pack, checking its directory entry on first use
+ *
+ * @param index the font
+ * @return the font, valid while the pack is open, nullptr if out of range,
+ *         malformed or a subset font
+ */
+const font_info_t *FontPack::Font(uint16_t index)
+{
+    const subset_font_info_t *font = Subset(index);
+    return (font && !font->remap) ? &font->info : nullptr;
+} // Font
+
+/**
+ * @brief A font of the pack by name
+ *
+ * @param name the font name
+ * @return the font, valid while the pack is open, nullptr if not in the pack or a subset font
+ */
+const font_info_t *FontPack::Find(const char *name)
+{
+    const subset_font_info_t *font = FindSubset(name);
+    return (font && !font->remap) ? &font->info : nullptr;
+} // Find
+
+/**
+ * @brief A font of the pack with the remap of its character codes, checking its directory entry on first use
+ *
+ * @param index the font
+ * @return the font, its remap null if whole, valid while the pack is open,
+ *         nullptr if out of range or malformed
+ */
+const subset_font_info_t *FontPack::Subset(uint16_t index)
+{
+    if (index >= m_fonts.size())
+        return nullptr;
+
+    subset_font_info_t &subset = m_fonts[index];
+    font_info_t &font = subset.info;
+    if (font.name)
+        return &subset;
+
+    font_pack_header_t header;
+    font_pack_entry_t entry;
+    memcpy(&header, m_data, sizeof(header));
+    memcpy(&entry, m_data + header.directory_offset + (index * sizeof(entry)), sizeof(entry));
+
+    size_t descriptors_bytes = (entry.char_end - entry.char_start + 1) * sizeof(font_char_desc_t);
+    if (!entry.height || entry.char_start > entry.char_end ||
+        entry.name_offset >= m_size || !memchr(m_data + entry.name_offset, 0, m_size - entry.name_offset) ||
+        entry.descriptors_offset % alignof(font_char_desc_t) || entry.descriptors_offset > m_size ||
+        m_size - entry.descriptors_offset < descriptors_bytes ||
+        entry.bitmap_offset > m_size || m_size - entry.bitmap_offset < entry.bitmap_bytes)
+        return nullptr;
+
+    if (entry.remap_offset && header.version > 1)
+    {
+        if (entry.remap_offset > m_size - 2 || m_data[entry.remap_offset] > m_data[entry.remap_offset + 1] ||
+            m_size - entry.remap_offset - 2 < (size_t)(m_data[entry.remap_offset + 1] - m_data[entry.remap_offset] + 1))
+            return nullptr;
+        subset.code_start = m_data[entry.remap_offset];
+        subset.code_end = m_data[entry.remap_offset + 1];
+        subset.remap = m_data + entry.remap_offset + 2;
+    }
+
+    font.height = entry.height;
+    font.c = entry.c;
+    font.char_start = entry.char_start;
+    font.char_end = entry.char_end;
+    font.char_descriptors = reinterpret_cast<const font_char_desc_t *>(m_data + entry.descriptors_offset);
+    font.bitmap = m_data + entry.bitmap_offset;
+    font.name = reinterpret_cast<const char *>(m_data + entry.name_offset);
+    return &subset;
+} // Subset
+
+/**
+ * @brief A font of the pack with the remap of its character codes, by name
+ *
+ * @param name the font name
+ * @return the font, its remap null if whole, valid while the pack is open,
+ *         nullptr if not in the pack
+ */
+const subset_font_info_t *FontPack::FindSubset(const char *name)
+{
+    for (uint16_t i = 0; i < m_fonts.size(); i++)
+    {
+        const subset_font_info_t *font = Subset(i);
+        if (font && !strcmp(font->info.name, name))
+            return font;
+    }
+    return nullptr;
+} // FindSubset
+
+/**
+ * @brief Checks every font and every character lies within the pack
+ *
+ * For packs from untrusted sources; the cost grows with the number of characters.
+ *
+ * @return true if every font can be rasterized without reading outside its bitmaps,
+ *         every subset code remapped to one of its characters
+ */
+bool FontPack::Verify()
+{
+    if (!m_data)
+        return false;
+
+    for (uint16_t i = 0; i < m_fonts.size(); i++)
+    {
+        const subset_font_info_t *subset = Subset(i);
+        if (!subset)
+            return false;
+        const font_info_t *font = &subset->info;
+
+        for (unsigned int c = 0; subset->remap && c <= (unsigned int)(subset->code_end - subset->code_start); c++)
+        {
+            if (subset->remap[c] != SUBSET_NO_CHAR && subset->remap[c] > font->char_end - font->char_start)
+                return false;
+        }
+
+        font_pack_header_t header;
+        font_pack_entry_t entry;
+        memcpy(&header, m_data, sizeof(header));
+        memcpy(&entry, m_data + header.directory_offset + (i * sizeof(entry)), sizeof(entry));
+        if (BitmapBytes(font) > entry.bitmap_bytes)
+            return false;
+    }
+    return true;
+} // Verify
@@ -0,0 +1,222 @@
+/*
+ Raster-Font Library Instrumentation
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "Instrument.h"
+
+static const char *COUNTER_NAMES[INSTRUMENT_COUNTERS] = {"glyphs", "bitmaps", "bytes_allocated", "cache_hits", "cache_misses", "paged_glyphs"};
+static const char *TIMER_NAMES[INSTRUMENT_TIMERS] = {"rasterize_char", "rasterize_string", "rasterize_into",
+                                                     "rasterize_batch", "measure_string", "character_breaks"};
+
+static std::atomic<InstrumentSink *> active_sink{nullptr}; ///< Where events go, the default sink if null
+
+/**
+ * @brief The latency bucket, the power of two at or below the latency
+ */
+static uint8_t bucket(uint64_t ns)
+{
+    uint8_t b = 0;
+    while ((ns >>= 1) && b < (LATENCY_BUCKETS - 1))
+    {
+        b++;
+    }
+    return b;
+} // bucket
+
+/**
+ * @brief The latency at or below which the percentage of calls completed
+ *
+ * Resolved to the upper bound of the histogram bucket, so within a factor of two.
+ *
+ * @param timer the timer
+ * @param percent the percentile, 0 to 100
+ * @return the latency in nanoseconds, 0 if there were no calls
+ */
+uint64_t InstrumentSnapshot::Percentile(InstrumentTimer timer, double percent) const
+{
+    uint64_t target = (uint64_t)((calls[timer] * percent) / 100);
+    uint64_t seen = 0;
+
+    for (uint8_t b = 0; b < LATENCY_BUCKETS && calls[timer]; b++)
+    {
+        seen += histogram[timer][b];
+        if (seen > target || seen == calls[timer])
+            return std::min<uint64_t>(max_ns[timer], (2ULL << b) - 1);
+    }
+    return 0;
+} // Percentile
+
+/**
+ * @brief Adds to a counter
+ *
+ * @param counter the counter
+ * @param n the amount to add
+ */
+void StatsSink::Count(InstrumentCounter counter, uint64_t n)
+{
+    m_counters[counter].fetch_add(n, std::memory_order_relaxed);
+} // Count
+
+/**
+ * @brief Records the latency of a call
+ *
+ * @param timer the timer
+ * @param ns the latency in nanoseconds
+ */
+void StatsSink::Latency(InstrumentTimer timer, uint64_t ns)
+{
+    m_calls[timer].fetch_add(1, std::memory_order_relaxed);
+    m_total_ns[timer].fetch_add(ns, std::memory_order_relaxed);
+    m_histogram[timer][bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t max = m_max_ns[timer].load(std::memory_order_relaxed);
+    while (ns > max && !m_max_ns[timer].compare_exchange_weak(max, ns, std::memory_order_relaxed))
+        ;
+} // Latency
+
+/**
+ * @brief Copies the aggregates
+ *
+ * Taken while events are arriving, the aggregates are each consistent but not with each other.
+ *
+ * @return the aggregates
+ */
+InstrumentSnapshot StatsSink::Snapshot() const
+{
+    InstrumentSnapshot snapshot;
+
+    for (int c = 0; c < INSTRUMENT_COUNTERS; c++)
+    {
+        snapshot.counters[c] = m_counters[c].load(std::memory_order_relaxed);
+    }
+    for (int t = 0; t < INSTRUMENT_TIMERS; t++)
+    {
+        snapshot.calls[t] = m_calls[t].load(std::memory_order_relaxed);
+        snapshot.total_ns[t] = m_total_ns[t].load(std::memory_order_relaxed);
+        snapshot.max_ns[t] = m_max_ns[t].load(std::memory_order_relaxed);
+        for (int b = 0; b < LATENCY_BUCKETS; b++)
+        {
+            snapshot.histogram[t][b] = m_histogram[t][b].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+} // Snapshot
+
+/**
+ * @brief Zeros the aggregates
+ */
+void StatsSink::Reset()
+{
+    for (std::atomic<uint64_t> &counter : m_counters)
+    {
+        counter = 0;
+    }
+    for (int t = 0; t < INSTRUMENT_TIMERS; t++)
+    {
+        m_calls[t] = 0;
+        m_total_ns[t] = 0;
+        m_max_ns[t] = 0;
+        for (std::atomic<uint64_t> &calls : m_histogram[t])
+        {
+            calls = 0;
+        }
+    }
+} // Reset
+
+/**
+ * @brief Writes the counters, and the call count, mean, p50, p99 and max latency of each timer
+ *
+ * @param out the file to write to
+ */
+void StatsSink::Report(FILE *out) const
+{
+    InstrumentSnapshot snapshot = Snapshot();
+
+    for (int c = 0; c < INSTRUMENT_COUNTERS; c++)
+    {
+        fprintf(out, "%-18s %12llu\n", COUNTER_NAMES[c], (unsigned long long)snapshot.counters[c]);
+    }
+    fprintf(out, "%-18s %12s %10s %10s %10s %10s\n", "call", "calls", "mean_ns", "p50_ns", "p99_ns", "max_ns");
+    for (int t = 0; t < INSTRUMENT_TIMERS; t++)
+    {
+        InstrumentTimer timer = static_cast<InstrumentTimer>(t);
+        fprintf(out, "%-18s %12llu %10llu %10llu %10llu %10llu\n", TIMER_NAMES[t], (unsigned long long)snapshot.calls[t],
+                (unsigned long long)(snapshot.calls[t] ? snapshot.total_ns[t] / snapshot.calls[t] : 0),
+                (unsigned long long)snapshot.Percentile(timer, 50), (unsigned long long)snapshot.Percentile(timer, 99),
+                (unsigned long long)snapshot.max_ns[t]);
+    }
+} // Report
+
+/**
+ * @brief The built in sink, aggregating every event since the program started or it was reset
+ *
+ * @return the default sink
+ */
+StatsSink &DefaultInstrumentSink()
+{
+    static StatsSink sink;
+    return sink;
+} // DefaultInstrumentSink
+
+/**
+ * @brief The sink events are going to
+ *
+ * @return the active sink
+ */
+InstrumentSink *ActiveInstrumentSink()
+{
+    InstrumentSink *sink = active_sink.load(std::memory_order_acquire);
+    return sink ? sink : &DefaultInstrumentSink();
+} // ActiveInstrumentSink
+
+/**
+ * @brief Sends events to another sink
+ *
+ * The sink must outlive its use; events already in flight may still reach the previous sink.
+ *
+ * @param sink the sink to use, nullptr for the default sink
+ * @return the previous sink
+ */
+InstrumentSink *SetInstrumentSink(InstrumentSink *sink)
+{
+    InstrumentSink *previous = active_sink.exchange(sink, std::memory_order_acq_rel);
+    return previous ? previous : &DefaultInstrumentSink();
+} // SetInstrumentSink
+
+/**
+ * @brief The name of a counter
+ *
+ * @param counter the counter
+ * @return the counter name
+ */
+const char *InstrumentCounterName(InstrumentCounter counter)
+{
+    return (counter < INSTRUMENT_COUNTERS) ? COUNTER_NAMES[counter] : "unknown";
+} // InstrumentCounterName
+
+/**
+ * @brief The name of a timer
+ *
+ * @param timer the timer
+ * @return the timer name
+ */
+const char *InstrumentTimerName(InstrumentTimer timer)
+{
+    return (timer < INSTRUMENT_TIMERS) ? TIMER_NAMES[timer] : "unknown";
+} // InstrumentTimerName
@@ -0,0 +1,407 @@
+/*
+ Raster-Font Library Marquee
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <string.h>
+
+#include "Marquee.h"
+#include "BitTranspose.h"
+
+#define MIN_COMPACT_BYTES 4096 ///< Consumed stream text worth moving the pending text down for
+
+/**
+ * @brief A byte in the bit order of the raster, reversed for LSB first rows
+ */
+static inline uint8_t ordered(uint8_t byte, bool lsb)
+{
+    return lsb ? BIT_REVERSE[byte] : byte;
+} // ordered
+
+/**
+ * @brief The bytes of UTF-8 text up to a character cut off at its end
+ *
+ * @param text the text
+ * @return the text size, less the bytes of an incomplete last character
+ */
+static size_t completeUtf8(std::string_view text)
+{
+    for (size_t back = 1; back <= std::min<size_t>(4, text.size()); back++)
+    {
+        unsigned char byte = text[text.size() - back];
+        if ((byte & 0xC0) == 0x80)
+            continue; // Continuation, look further back for the lead
+
+        size_t length = (byte >= 0xF0) ? 4 : (byte >= 0xE0) ? 3 : (byte >= 0xC0) ? 2 : 1;
+        return (length > back) ? text.size() - back : text.size();
+    }
+    return text.size();
+} // completeUtf8
+
+/**
+ * @brief Instantiates an empty marquee
+ *
+ * A font manager turned from upright leaves the marquee inert, Columns and
+ * Window returning false.
+ *
+ * @param fm the font manager to rasterize glyphs with, referenced for the life of the marquee
+ * @param window_pixels the width of the window
+ * @param bitOffset the position offset of the output, across (LRTB) or down (PTBLR) the window
+ */
+Marquee::Marquee(FontManager &fm, uint16_t window_pixels, uint16_t bitOffset)
+    : m_fm{fm}, m_raster{fm.FontRaster()}, m_window{window_pixels}, m_bitOffset{static_cast<uint16_t>(bitOffset % 8)},
+      m_upright{fm.FontOrientation() == FontManager::T}
+{
+    if (!m_upright)
+        return; // Turned glyphs do not lay out along the window rows
+
+    m_narrowest = 0xFF;
+    for (unsigned int c = 0; c < 256; c++)
+    {
+        uint8_t advance = fm.CharWidth(c) + fm.FontC();
+        m_narrowest = std::min(m_narrowest, advance);
+        m_blank = std::max(m_blank, advance);
+    }
+    m_narrowest = std::max<uint8_t>(m_narrowest, 1);
+
+    /*
+     * The glyphs cover the window and the part of the leftmost scrolled out, and
+     * the last one loaded may overhang by up to the widest advance; no glyph,
+     * blanks included, advances less than the narrowest character
+     */
+    m_glyphs.resize(((m_window + (2 * m_blank)) / m_narrowest) + 2);
+    m_slot_bytes = fm.MaxCharBytes();
+    m_bitmaps.resize(m_glyphs.size() * m_slot_bytes);
+
+    Fill(m_window);
+} // Marquee
+
+/**
+ * @brief Appends text to the stream
+ *
+ * Blank columns queued at the right of the window give way, so the text
+ * follows the current window contents directly. UTF-8 text is mapped to the
+ * font as it is pushed, a character cut off at the end of the text waiting for
+ * the rest of it in the next push.
+ *
+ * @param text the characters to scroll in after those already pushed
+ */
+void Marquee::Push(std::string_view text)
+{
+    if (text.empty())
+        return;
+
+    while (m_count)
+    /*
+     * Drop or shorten trailing blanks
+     */
+    {
+        Glyph &tail = m_glyphs[(m_head + m_count - 1) % m_glyphs.size()];
+        if (tail.width)
+            break;
+
+        int32_t left = (int32_t)m_span - tail.advance - m_skip; // Window position of the blank, -m_skip for the leftmost
+        if (left >= m_window)
+        {
+            m_span -= tail.advance;
+            if (!--m_count)
+                m_skip = 0;
+            continue;
+        }
+
+        int32_t visible = std::max<int32_t>(m_window - left, m_narrowest);
+        if (visible < tail.advance)
+        {
+            m_span -= tail.advance - visible;
+            tail.advance = visible;
+        }
+        break;
+    }
+
+    if (m_read >= MIN_COMPACT_BYTES && m_read * 2 >= m_pending.size())
+    {
+        m_pending.erase(0, m_read);
+        m_read = 0;
+    }
+
+    if (m_fm.Utf8())
+    /*
+     * Map whole characters, holding back a cut off one
+     */
+    {
+        m_partial.append(text.data(), text.size());
+        size_t complete = completeUtf8(m_partial);
+        std::string_view bytes = m_fm.FontText(std::string_view(m_partial).substr(0, complete), m_text);
+        m_pending.append(bytes.data(), bytes.size());
+        m_partial.erase(0, complete);
+        return;
+    }
+    m_pending.append(text.data(), text.size());
+} // Push
+
+/**
+ * @brief The characters of the stream not yet scrolled into the window
+ *
+ * @return the pending character count
+ */
+size_t Marquee::Pending() const
+{
+    return m_pending.size() - m_read;
+} // Pending
+
+/**
+ * @brief The width of the window
+ *
+ * @return the window width in pixels
+ */
+uint16_t Marquee::WindowPixels() const
+{
+    return m_window;
+} // WindowPixels
+
+/**
+ * @brief Scrolls the window left without producing output
+ *
+ * @param columns the pixels to scroll
+ */
+void Marquee::Step(uint16_t columns)
+{
+    if (!m_upright)
+        return;
+
+    while (columns)
+    {
+        if (!m_count)
+            Fill(1);
+
+        const Glyph &head = m_glyphs[m_head];
+        uint16_t n = std::min<uint16_t>(columns, head.advance - m_skip);
+        m_skip += n;
+        columns -= n;
+
+        if (m_skip == head.advance)
+        /*
+         * The glyph has scrolled out
+         */
+        {
+            m_span -= head.advance;
+            m_head = (m_head + 1) % m_glyphs.size();
+            m_count--;
+            m_skip = 0;
+        }
+    }
+    Fill(m_window);
+} // Step
+
+/**
+ * @brief Scrolls the window left and bitmaps the columns exposed on the right
+ *
+ * The view supplies data, size, stride and clear, as FontManager::RasterizeInto,
+ * and is laid out for the columns.
+ *
+ * @param columns the pixels to scroll, no more than the window width
+ * @param view the bitmap to raster into
+ * @return false if the marquee is inert, the columns are wider than the window, the
+ *         buffer too small or the stride too narrow, nothing being scrolled or written
+ */
+bool Marquee::Columns(uint16_t columns, FontManager::BitmapView &view)
+{
+    if (!m_upright || columns > m_window || !FontManager::PrepareView(view, m_raster, {columns, m_fm.FontHeight()}, m_bitOffset))
+        return false;
+    if (view.clear && FontManager::PixelBytes(m_raster))
+        m_fm.ClearView(view);
+
+    Step(columns);
+    Render(m_window - columns, columns, view);
+    return true;
+} // Columns
+
+/**
+ * @brief Bitmaps the whole window at its current scroll position
+ *
+ * The view supplies data, size, stride and clear, as FontManager::RasterizeInto,
+ * and is laid out for the window.
+ *
+ * @param view the bitmap to raster into
+ * @return false if the marquee is inert, the buffer too small or the stride too narrow,
+ *         nothing being written
+ */
+bool Marquee::Window(FontManager::BitmapView &view)
+{
+    if (!m_upright || !FontManager::PrepareView(view, m_raster, {m_window, m_fm.FontHeight()}, m_bitOffset))
+        return false;
+    if (view.clear && FontManager::PixelBytes(m_raster))
+        m_fm.ClearView(view);
+
+    Render(0, m_window, view);
+    return true;
+} // Window
+
+/**
+ * @brief Loads glyphs from the stream, or blanks, until the window is covered to a width
+ *
+ * @param pixels the width from the left of the window to cover
+ */
+void Marquee::Fill(uint32_t pixels)
+{
+    while (m_span - m_skip < pixels)
+    {
+        size_t slot = (m_head + m_count) % m_glyphs.size();
+        Glyph &glyph = m_glyphs[slot];
+
+        if (m_read < m_pending.size())
+        {
+            unsigned char c = m_pending[m_read++];
+            FontManager::BitmapView view;
+            view.data = m_bitmaps.data() + (slot * m_slot_bytes);
+            view.size = m_slot_bytes;
+            bool laid = m_fm.RasterizeInto(c, view, FontManager::PagedRaster(m_raster) ? m_bitOffset : 0); // LRTB glyphs are shifted as rendered
+
+            glyph.width = laid ? view.width_pixels - view.width_offset_pixels : 0;
+            glyph.advance = m_fm.CharWidth(c) + m_fm.FontC();
+            glyph.stride = view.stride;
+            glyph.rows = laid ? view.bytes_per_column : 0;
+        }
+        else
+        {
+            glyph.width = 0;
+            glyph.advance = m_blank;
+            glyph.stride = 0;
+            glyph.rows = 0;
+        }
+
+        m_span += glyph.advance;
+        m_count++;
+    }
+} // Fill
+
+/**
+ * @brief ORs columns of the window into a laid out view
+ *
+ * @param from the first column, from the left of the window
+ * @param columns the number of columns
+ * @param view the view, laid out for the columns
+ */
+void Marquee::Render(uint16_t from, uint16_t columns, FontManager::BitmapView &view)
+{
+    int32_t left = -(int32_t)m_skip; // Window position of the glyph
+    int32_t end = from + columns;
+
+    for (size_t i = 0; i < m_count && left < end; i++)
+    {
+        const Glyph &glyph = m_glyphs[(m_head + i) % m_glyphs.size()];
+        int32_t first = std::max<int32_t>(left, from);
+        int32_t last = std::min<int32_t>(left + glyph.width, end);
+
+        if (first < last)
+        {
+            const uint8_t *bitmap = m_bitmaps.data() + (((m_head + i) % m_glyphs.size()) * m_slot_bytes);
+            uint16_t rows = std::min(view.bytes_per_column, glyph.rows); // Of both the window and the glyph
+
+            if (FontManager::PagedRaster(m_raster))
+            {
+                for (uint16_t page = 0; page < rows; page++)
+                {
+                    const uint8_t *src = bitmap + ((size_t)glyph.stride * page) + (first - left);
+                    uint8_t *dest = view.data + ((size_t)view.stride * page) + (first - from);
+                    for (int32_t x = first; x < last; x++)
+                    {
+                        *dest++ |= *src++;
+                    }
+                }
+            }
+            else if (uint8_t bytes = FontManager::PixelBytes(m_raster))
+            /*
+             * Copy the glyph pixels [first, last) of each row, background included
+             */
+            {
+                for (uint16_t row = 0; row < rows; row++)
+                {
+                    memcpy(view.data + ((size_t)view.stride * row) + ((first - from) * bytes),
+                           bitmap + ((size_t)glyph.stride * row) + ((first - left) * bytes), (last - first) * bytes);
+                }
+            }
+            else if (uint8_t bits = FontManager::GrayBits(m_raster))
+            /*
+             * OR the glyph pixels [s, s + length) of each row into the pixels from d,
+             * a packed pixel at a time
+             */
+            {
+                int32_t s = first - left;
+                int32_t length = last - first;
+                int32_t d = (first - from) + view.width_offset_pixels;
+                uint8_t mask = (1 << bits) - 1;
+
+                for (uint16_t row = 0; row < rows; row++)
+                {
+                    const uint8_t *src = bitmap + ((size_t)glyph.stride * row);
+                    uint8_t *dest = view.data + ((size_t)view.stride * row);
+
+                    for (int32_t pixel = 0; pixel < length; pixel++)
+                    {
+                        int32_t read = (s + pixel) * bits, write = (d + pixel) * bits;
+                        uint8_t level = (src[read / 8] >> (8 - bits - (read % 8))) & mask;
+                        dest[write / 8] |= level << (8 - bits - (write % 8));
+                    }
+                }
+            }
+            else
+            /*
+             * Copy the glyph bits [s, s + length) of each row to the bits from d,
+             * one source byte at a time, masked to the copied bits
+             */
+            {
+                int32_t s = first - left;
+                int32_t length = last - first;
+                int32_t d = (first - from) + view.width_offset_pixels;
+                bool lsb = m_raster == FontManager::LRTB_LSB; // Bits copied as MSB first, reversed on reading and writing
+
+                for (uint16_t row = 0; row < rows; row++)
+                {
+                    const uint8_t *src = bitmap + ((size_t)glyph.stride * row);
+                    uint8_t *dest = view.data + ((size_t)view.stride * row);
+
+                    for (int32_t byte = s / 8; byte * 8 < s + length; byte++)
+                    {
+                        int32_t lo = std::max(s, byte * 8) - (byte * 8);
+                        int32_t hi = std::min(s + length, (byte * 8) + 8) - (byte * 8);
+                        uint8_t bits = ordered(src[byte], lsb) & (0xFF >> lo) & (0xFF << (8 - hi));
+                        if (!bits)
+                            continue;
+
+                        int32_t at = d + (byte * 8) - s; // Destination bit of the source byte's first bit
+                        if (at < 0)
+                        {
+                            dest[0] |= ordered(bits << -at, lsb);
+                        }
+                        else
+                        {
+                            dest[at / 8] |= ordered(bits >> (at % 8), lsb);
+                            if (at % 8)
+                            {
+                                uint8_t spill = bits << (8 - (at % 8));
+                                if (spill)
+                                    dest[(at / 8) + 1] |= ordered(spill, lsb);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        left += glyph.advance;
+    }
+} // Render
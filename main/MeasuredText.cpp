@@ -0,0 +1,324 @@
+/*
+ Raster-Font Library Measured Text
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "MeasuredText.h"
+
+/**
+ * @brief Tabulates the advances of the font
+ *
+ * @param fm the font manager of the font to measure in, referenced to map UTF-8 text
+ */
+CharAdvances::CharAdvances(FontManager &fm) : m_fm{fm}, m_utf8{fm.Utf8()}
+{
+    for (unsigned int c = 0; c < 256; c++)
+    {
+        m_advance[c] = fm.CharWidth(c) + (c ? fm.FontC() : 0); // No kerning after a null, as MeasureString
+    }
+} // CharAdvances
+
+/**
+ * @brief Does a byte continue a UTF-8 character, so is no character start
+ *
+ * @param byte the byte of the text
+ * @return true for UTF-8 continuation bytes of UTF-8 text
+ */
+bool CharAdvances::Continues(char byte) const
+{
+    return m_utf8 && (static_cast<unsigned char>(byte) & 0xC0) == 0x80;
+} // Continues
+
+/**
+ * @brief The first character start at or after a position
+ *
+ * @param text the text
+ * @param pos the position, no more than the text size
+ * @return the position moved past any bytes continuing a character
+ */
+size_t CharAdvances::CharStart(std::string_view text, size_t pos) const
+{
+    while (pos < text.size() && Continues(text[pos]))
+    {
+        pos++;
+    }
+    return pos;
+} // CharStart
+
+/**
+ * @brief Measures text, the offset after each byte
+ *
+ * @param text the text, whole UTF-8 characters for UTF-8 font managers
+ * @param offset the offset of the start of the text
+ * @param offsets the offset after each byte of the text
+ * @return the offset after the text
+ */
+uint32_t CharAdvances::Offsets(std::string_view text, uint32_t offset, uint32_t *offsets)
+{
+    std::string_view bytes = m_utf8 ? m_fm.FontText(text, m_bytes, &m_starts) : text;
+
+    if (m_starts.empty() || !m_utf8)
+    /*
+     * A byte a character
+     */
+    {
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            offset += m_advance[static_cast<unsigned char>(text[i])];
+            offsets[i] = offset;
+        }
+        return offset;
+    }
+
+    size_t next = 0; // Next font byte
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if (next < bytes.size() && m_starts[next] == i)
+            offset += m_advance[static_cast<unsigned char>(bytes[next++])];
+        offsets[i] = offset;
+    }
+    return offset;
+} // Offsets
+
+/**
+ * @brief Measures the text in the font
+ *
+ * @param fm the font manager of the font to measure in, referenced for the life of the text when UTF-8
+ * @param text the text
+ */
+MeasuredText::MeasuredText(FontManager &fm, std::string_view text) : m_c{fm.FontC()}, m_advances{fm}
+{
+    Assign(text);
+} // MeasuredText
+
+/**
+ * @brief The text
+ *
+ * @return the text, valid until the next edit
+ */
+std::string_view MeasuredText::Text() const
+{
+    return m_text;
+} // Text
+
+/**
+ * @brief The number of characters
+ *
+ * @return the text length
+ */
+size_t MeasuredText::Size() const
+{
+    return m_text.size();
+} // Size
+
+/**
+ * @brief The width of the text
+ *
+ * @return the width in pixels
+ */
+uint32_t MeasuredText::Width() const
+{
+    return m_offset.back();
+} // Width
+
+/**
+ * @brief The width of a substring, in constant time
+ *
+ * @param begin the first character
+ * @param end one past the last character, clamped to the text
+ * @return the width in pixels, 0 if empty
+ */
+uint32_t MeasuredText::Width(size_t begin, size_t end) const
+{
+    end = std::min(end, m_text.size());
+    return (begin < end) ? m_offset[end] - m_offset[begin] : 0;
+} // Width
+
+/**
+ * @brief The pixel offset of a character from the start of the text, in constant time
+ *
+ * @param pos the character, the text size giving the total width
+ * @return the offset in pixels
+ */
+uint32_t MeasuredText::Offset(size_t pos) const
+{
+    return m_offset[std::min(pos, m_text.size())];
+} // Offset
+
+/**
+ * @brief The character under a pixel offset, in logarithmic time
+ *
+ * Each character covers its advance, the spacing after it included.
+ *
+ * @param pixel the offset from the start of the text
+ * @return the character, the text size if the offset is beyond the text
+ */
+size_t MeasuredText::CharAt(uint32_t pixel) const
+{
+    std::vector<uint32_t>::const_iterator after = std::upper_bound(m_offset.begin(), m_offset.end(), pixel);
+    if (after == m_offset.end())
+        return m_text.size();
+
+    size_t pos = (after - m_offset.begin()) - 1;
+    while (pos > 0 && m_advances.Continues(m_text[pos]))
+    {
+        pos--;
+    }
+    return pos;
+} // CharAt
+
+/**
+ * @brief The caret position nearest a pixel offset, in logarithmic time
+ *
+ * @param pixel the offset from the start of the text
+ * @return the character position, 0 to the text size, the caret goes before
+ */
+size_t MeasuredText::CaretAt(uint32_t pixel) const
+{
+    size_t pos = std::lower_bound(m_offset.begin(), m_offset.end(), pixel) - m_offset.begin();
+    if (pos > m_text.size())
+        return m_text.size();
+
+    pos = m_advances.CharStart(m_text, pos);
+    if (pos > 0)
+    /*
+     * The nearer of this character start and the one before
+     */
+    {
+        size_t before = pos - 1;
+        while (before > 0 && m_advances.Continues(m_text[before]))
+        {
+            before--;
+        }
+        if ((pixel - m_offset[before]) < (m_offset[pos] - pixel))
+            pos = before;
+    }
+    return pos;
+} // CaretAt
+
+/**
+ * @brief The right edge of a character's glyph, its offset plus width
+ */
+uint32_t MeasuredText::BreakEdge(size_t pos) const
+{
+    return m_offset[pos + 1] - (m_text[pos] ? m_c : 0);
+} // BreakEdge
+
+/**
+ * @brief For wrapping text, the characters that start each line after the first
+ *
+ * The positions FontManager::CharacterBreaks gives, each found by binary search,
+ * so logarithmic time per line. The glyph edges are non-decreasing, so the first
+ * character of a line to overrun is the first whose edge is beyond the line.
+ * A line is never broken before its first character: one wider than the line
+ * takes a line of its own.
+ *
+ * @param pixels the width of a line
+ * @return the character positions that abut the pixel boundary
+ */
+std::vector<uint32_t> MeasuredText::Breaks(uint16_t pixels) const
+{
+    std::vector<uint32_t> breaks;
+    size_t from = m_advances.CharStart(m_text, 1); // First character that may break, after the first of the line
+    uint32_t line_start = 0;  // Offset of the current line
+
+    while (from < m_text.size())
+    {
+        uint32_t limit = line_start + pixels;
+        size_t low = from, high = m_text.size();
+        while (low < high)
+        /*
+         * First character from which the glyph edge passes the limit
+         */
+        {
+            size_t mid = low + ((high - low) / 2);
+            if (BreakEdge(mid) > limit)
+                high = mid;
+            else
+                low = mid + 1;
+        }
+        if (low == m_text.size())
+            break;
+
+        breaks.push_back(low);
+        line_start = m_offset[low];
+        from = m_advances.CharStart(m_text, low + 1);
+    }
+    return breaks;
+} // Breaks
+
+/**
+ * @brief Replaces the text, measuring it all
+ *
+ * @param text the new text
+ */
+void MeasuredText::Assign(std::string_view text)
+{
+    m_text.assign(text.data(), text.size());
+    m_offset.resize(text.size() + 1);
+
+    m_offset[0] = 0;
+    m_advances.Offsets(text, 0, m_offset.data() + 1);
+} // Assign
+
+/**
+ * @brief Inserts text, measuring only the inserted characters
+ *
+ * @param pos the position to insert at, clamped to the text and moved to a character start
+ * @param str the characters to insert
+ */
+void MeasuredText::Insert(size_t pos, std::string_view str)
+{
+    if (str.empty())
+        return;
+
+    pos = m_advances.CharStart(m_text, std::min(pos, m_text.size()));
+    m_text.insert(pos, str.data(), str.size());
+
+    m_offset.insert(m_offset.begin() + pos + 1, str.size(), 0);
+    uint32_t offset = m_advances.Offsets(str, m_offset[pos], m_offset.data() + pos + 1);
+
+    uint32_t delta = offset - m_offset[pos];
+    for (size_t i = pos + 1 + str.size(); i < m_offset.size(); i++)
+    {
+        m_offset[i] += delta;
+    }
+} // Insert
+
+/**
+ * @brief Erases characters, shifting the offsets after them
+ *
+ * @param pos the first character to erase, moved to a character start
+ * @param count the number of characters, bytes for UTF-8, clamped to the text and extended to a character end
+ */
+void MeasuredText::Erase(size_t pos, size_t count)
+{
+    if (pos >= m_text.size() || !count)
+        return;
+
+    pos = m_advances.CharStart(m_text, pos);
+    count = m_advances.CharStart(m_text, pos + std::min(count, m_text.size() - pos)) - pos;
+    uint32_t delta = m_offset[pos + count] - m_offset[pos];
+
+    m_text.erase(pos, count);
+    m_offset.erase(m_offset.begin() + pos + 1, m_offset.begin() + pos + 1 + count);
+    for (size_t i = pos + 1; i < m_offset.size(); i++)
+    {
+        m_offset[i] -= delta;
+    }
+} // Erase
@@ -0,0 +1,167 @@
+/*
+ Raster-Font Library Paged Fonts
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <array>
+#include <stddef.h>
+
+#include "PagedFonts.h"
+#include "RawFonts.h"
+
+/**
+ * The fonts to bake paged rasters for, as a comma separated list of font names,
+ * or "all". Each baked font adds about its own bitmap size again to flash.
+ */
+#ifndef RASTERFONT_PAGED_FONTS
+#define RASTERFONT_PAGED_FONTS ""
+#endif
+
+namespace
+{
+
+/**
+ * @brief The number of pages to hold a character of the font
+ */
+constexpr uint8_t pageCount(const font_info_t &font)
+{
+    return ((font.height - 1) / 8) + 1;
+} // pageCount
+
+/**
+ * @brief The bytes needed to hold every character of the font paged
+ */
+constexpr size_t pagedSize(const font_info_t &font)
+{
+    size_t size = 0;
+    for (size_t c = 0; c < charCount(font); c++)
+    {
+        size += font.char_descriptors[c].width * pageCount(font);
+    }
+    return size;
+} // pagedSize
+
+/**
+ * @brief Paged character data and the offset of each character
+ */
+template <size_t Count, size_t Size>
+struct PagedFont
+{
+    std::array<uint16_t, Count> offsets{};
+    std::array<uint8_t, Size> pages{};
+};
+
+/**
+ * @brief Transposes every character of the font into pages
+ *
+ * @param font the L-R/T-B font
+ * @return the paged font
+ */
+template <size_t Count, size_t Size>
+constexpr PagedFont<Count, Size> pageFont(const font_info_t &font)
+{
+    PagedFont<Count, Size> paged{};
+    uint16_t offset = 0;
+
+    for (size_t c = 0; c < Count; c++)
+    {
+        font_char_desc_t char_desc = font.char_descriptors[c];
+        const uint8_t *char_bitmap = font.bitmap + char_desc.offset;
+        uint8_t horizontal_read_bytes = 1 + ((char_desc.width - 1) / 8);
+
+        paged.offsets[c] = offset;
+        for (uint8_t row = 0; row < font.height; row++)
+        {
+            for (uint8_t column = 0; column < horizontal_read_bytes; column++)
+            {
+                uint8_t word = *char_bitmap++;
+                for (uint8_t bit = 0; bit < 8 && (column * 8) + bit < char_desc.width; bit++)
+                {
+                    if (word & (0x80 >> bit))
+                    {
+                        paged.pages[offset + ((row / 8) * char_desc.width) + (column * 8) + bit] |= 1 << (row % 8);
+                    }
+                }
+            }
+        }
+        offset += char_desc.width * pageCount(font);
+    }
+    return paged;
+} // pageFont
+
+/**
+ * @brief The paged raster of a font, or nullptr when the font is not baked
+ */
+template <const font_info_t &Font, bool Bake = bakeFont(RASTERFONT_PAGED_FONTS, Font.name)>
+struct Paged
+{
+    static constexpr const paged_font_info_t *info = nullptr;
+};
+
+template <const font_info_t &Font>
+struct Paged<Font, true>
+{
+    static constexpr PagedFont<charCount(Font), pagedSize(Font)> font = pageFont<charCount(Font), pagedSize(Font)>(Font);
+    static constexpr paged_font_info_t value = {font.pages.data(), font.offsets.data()};
+    static constexpr const paged_font_info_t *info = &value;
+};
+
+} // namespace
+
+const paged_font_info_t *paged_fonts[NUM_FONTS] = {
+    Paged<raw::_fonts_glcd_5x7_info>::info,
+#ifdef FONTS_ASCII
+    /*
+     * ascii fonts
+     */
+    Paged<raw::_fonts_bitocra_4x7_ascii_info>::info,
+    Paged<raw::_fonts_roboto_8pt_ascii_info>::info,
+    Paged<raw::_fonts_roboto_10pt_ascii_info>::info,
+    Paged<raw::_font_tahoma_8pt_ascii_info>::info,
+#endif
+#ifdef FONTS_ISO8859
+    /*
+     * iso8859_1 fonts
+     */
+    Paged<raw::_fonts_bitocra_6x11_iso8859_1_info>::info,
+    Paged<raw::_fonts_bitocra_7x13_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_6x12_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_8x14_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_10x18_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_11x22_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_12x24_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_14x28_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_16x32_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_bold_8x14_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_bold_10x18_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_bold_11x22_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_bold_12x24_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_bold_14x28_iso8859_1_info>::info,
+    Paged<raw::_fonts_terminus_bold_16x32_iso8859_1_info>::info,
+#endif
+#ifdef FONTS_KOI8
+    /*
+     * koi8_r fonts
+     */
+    Paged<raw::_fonts_terminus_6x12_koi8_r_info>::info,
+    Paged<raw::_fonts_terminus_8x14_koi8_r_info>::info,
+    Paged<raw::_fonts_terminus_14x28_koi8_r_info>::info,
+    Paged<raw::_fonts_terminus_16x32_koi8_r_info>::info,
+    Paged<raw::_fonts_terminus_bold_8x14_koi8_r_info>::info,
+    Paged<raw::_fonts_terminus_bold_14x28_koi8_r_info>::info,
+    Paged<raw::_fonts_terminus_bold_16x32_koi8_r_info>::info
+#endif
+};
@@ -0,0 +1,234 @@
+/*
+ Raster-Font Library Parallel Rasterizer
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+
+#include "ParallelRasterizer.h"
+
+#define CHUNKS_PER_THREAD 8   ///< Wrap chunks queued per worker, for balancing by stealing
+#define MIN_CHUNK_BYTES 4096  ///< Smallest wrap chunk worth a task
+#define MAX_WRAP_CHARS 0xFFFF ///< Longest run CharacterBreaks can index
+
+/**
+ * @brief Instantiates the rasterizer and its workers
+ *
+ * @param fontIndex the font to produce
+ * @param raster The direction to rasterize the pages
+ * @param threads the number of workers, 0 for one per hardware thread
+ */
+ParallelRasterizer::ParallelRasterizer(uint8_t fontIndex, FontManager::Raster raster, unsigned threads)
+    : m_raster{raster}, m_pool{threads}
+{
+    for (unsigned i = 0; i < m_pool.Threads(); i++)
+    {
+        m_managers.emplace_back(new FontManager(fontIndex, raster));
+    }
+} // ParallelRasterizer
+
+/**
+ * @brief The number of workers
+ *
+ * @return worker count
+ */
+unsigned ParallelRasterizer::Threads() const
+{
+    return m_pool.Threads();
+} // Threads
+
+/**
+ * @brief The number of tasks balanced onto another worker by stealing
+ *
+ * @return steals since the rasterizer was instantiated
+ */
+uint64_t ParallelRasterizer::Steals() const
+{
+    return m_pool.Steals();
+} // Steals
+
+/**
+ * @brief Wraps a document into lines that fit the width
+ *
+ * Lines end at newlines, carriage returns before them being dropped, and are
+ * broken where the next character would overrun the width. Chunks of whole
+ * lines are wrapped in parallel.
+ *
+ * @param document the text
+ * @param width_pixels the width to fit
+ * @return the wrapped lines in document order, viewing the document
+ */
+std::vector<std::string_view> ParallelRasterizer::Wrap(std::string_view document, uint16_t width_pixels)
+{
+    std::vector<std::string_view> lines;
+    FontManager &fm = *m_managers[0];
+
+    if (document.empty() || width_pixels <= fm.FontC())
+        return lines;
+
+    uint16_t budget = width_pixels - fm.FontC(); // The trailing "C" of the last character must fit too
+
+    size_t chunks = std::min<size_t>(Threads() * CHUNKS_PER_THREAD, (document.size() / MIN_CHUNK_BYTES) + 1);
+    std::vector<size_t> starts(chunks + 1, document.size());
+    starts[0] = 0;
+    for (size_t i = 1; i < chunks; i++)
+    /*
+     * Chunk boundaries just after a newline
+     */
+    {
+        size_t pos = std::max(starts[i - 1], (document.size() * i) / chunks);
+        size_t newline = document.find('\n', pos);
+        starts[i] = (newline == std::string_view::npos) ? document.size() : newline + 1;
+    }
+
+    std::vector<std::vector<std::string_view>> chunk_lines(chunks);
+    std::atomic<bool> too_narrow{false};
+
+    m_pool.ParallelFor(chunks, [&](size_t chunk, unsigned worker) {
+        FontManager &wfm = *m_managers[worker];
+        std::vector<std::string_view> &out = chunk_lines[chunk];
+        std::string_view text = document.substr(starts[chunk], starts[chunk + 1] - starts[chunk]);
+
+        while (!text.empty())
+        {
+            size_t end = text.find('\n');
+            std::string_view line = text.substr(0, end);
+            text.remove_prefix((end == std::string_view::npos) ? text.size() : end + 1);
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+
+            if (line.empty())
+            {
+                out.push_back(line);
+                continue;
+            }
+
+            while (!line.empty())
+            /*
+             * Wrap the line a run at a time, the unfinished last line of a run
+             * carried into the next
+             */
+            {
+                std::string_view run = line.substr(0, MAX_WRAP_CHARS);
+
+                std::vector<uint16_t> breaks = wfm.CharacterBreaks(run, budget);
+                if (breaks.empty() && wfm.MeasureString(run).x_pixels > width_pixels)
+                {
+                    too_narrow = true; // Not even one character fits
+                    return;
+                }
+
+                size_t from = 0;
+                for (uint16_t at : breaks)
+                {
+                    if (at > from)
+                    {
+                        out.push_back(run.substr(from, at - from));
+                        from = at;
+                    }
+                }
+                if (run.size() == line.size() || !from)
+                {
+                    out.push_back(run.substr(from)); // The end of the line, or a whole run without a break to carry from
+                    from = run.size();
+                }
+                line.remove_prefix(from);
+            }
+        }
+    });
+
+    if (too_narrow)
+        return lines;
+
+    for (std::vector<std::string_view> &chunk : chunk_lines)
+    {
+        lines.insert(lines.end(), chunk.begin(), chunk.end());
+    }
+    return lines;
+} // Wrap
+
+/**
+ * @brief Rasterizes a document into page images
+ *
+ * @param document the text
+ * @param width_pixels the page width
+ * @param height_pixels the page height
+ * @return the pages in document order, empty if a line of the font does not fit the page
+ */
+std::vector<ParallelRasterizer::Page> ParallelRasterizer::Rasterize(std::string_view document, uint16_t width_pixels, uint16_t height_pixels)
+{
+    std::vector<Page> pages;
+    uint8_t line_height = m_managers[0]->FontHeight();
+    uint16_t lines_per_page = line_height ? height_pixels / line_height : 0;
+
+    if (!lines_per_page)
+        return pages;
+
+    std::vector<std::string_view> lines = Wrap(document, width_pixels);
+
+    pages.resize((lines.size() + lines_per_page - 1) / lines_per_page);
+
+    m_pool.ParallelFor(pages.size(), [&](size_t index, unsigned worker) {
+        FontManager &fm = *m_managers[worker];
+        Page &page = pages[index];
+
+        page.first_line = index * lines_per_page;
+        page.lines = std::min<size_t>(lines_per_page, lines.size() - page.first_line);
+        if (FontManager::PixelBytes(m_raster))
+        {
+            page.stride = width_pixels * FontManager::PixelBytes(m_raster);
+            page.bytes_per_column = height_pixels;
+        }
+        else if (uint8_t bits = FontManager::GrayBits(m_raster))
+        {
+            page.stride = ((width_pixels * bits) + 7) / 8;
+            page.bytes_per_column = height_pixels;
+        }
+        else if (!FontManager::PagedRaster(m_raster))
+        {
+            page.stride = ((width_pixels - 1) / 8) + 1;
+            page.bytes_per_column = height_pixels;
+        }
+        else
+        {
+            page.stride = width_pixels;
+            page.bytes_per_column = ((height_pixels - 1) / 8) + 1;
+        }
+        page.data.assign((size_t)page.stride * page.bytes_per_column, 0);
+
+        for (uint16_t line = 0; line < page.lines; line++)
+        /*
+         * OR each line straight into the page image
+         */
+        {
+            uint16_t y = line * line_height;
+            bool lrtb = !FontManager::PagedRaster(m_raster);
+            if (m_raster == FontManager::PBTLR)
+                y = height_pixels - y - line_height; // Line bottom, from the page bottom
+            size_t start = (size_t)page.stride * (lrtb ? y : y / 8);
+
+            FontManager::BitmapView view;
+            view.data = page.data.data() + start;
+            view.size = page.data.size() - start;
+            view.stride = page.stride;
+            view.clear = false;
+            fm.RasterizeInto(lines[page.first_line + line], view, lrtb ? 0 : y % 8);
+        }
+    });
+
+    return pages;
+} // Rasterize
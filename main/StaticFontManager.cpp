@@ -0,0 +1,170 @@
+/*
+ Raster-Font Library Static Font Manager
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include "RawFonts.h"
+#include "StaticFontManager.h"
+
+namespace
+{
+
+/**
+ * @brief Do the compile time metrics of the tag match the font
+ *
+ * @param font the font the tag names
+ * @return true if they match
+ */
+template <typename Font>
+constexpr bool matches(const font_info_t &font)
+{
+    uint8_t max_width = 0;
+    for (size_t c = 0; c <= (size_t)(font.char_end - font.char_start); c++)
+    {
+        if (font.char_descriptors[c].width > max_width)
+            max_width = font.char_descriptors[c].width;
+    }
+    return Font::height == font.height && Font::c == font.c && Font::char_start == font.char_start &&
+           Font::char_end == font.char_end && Font::max_width == max_width;
+} // matches
+
+static_assert(matches<FontTags::glcd_5x7>(raw::_fonts_glcd_5x7_info), "Font tag glcd_5x7 does not match the font");
+static_assert(matches<FontTags::bitocra_4x7_ascii>(raw::_fonts_bitocra_4x7_ascii_info), "Font tag bitocra_4x7_ascii does not match the font");
+static_assert(matches<FontTags::roboto_8pt_ascii>(raw::_fonts_roboto_8pt_ascii_info), "Font tag roboto_8pt_ascii does not match the font");
+static_assert(matches<FontTags::roboto_10pt_ascii>(raw::_fonts_roboto_10pt_ascii_info), "Font tag roboto_10pt_ascii does not match the font");
+static_assert(matches<FontTags::tahoma_8pt_ascii>(raw::_font_tahoma_8pt_ascii_info), "Font tag tahoma_8pt_ascii does not match the font");
+static_assert(matches<FontTags::bitocra_6x11_iso8859_1>(raw::_fonts_bitocra_6x11_iso8859_1_info), "Font tag bitocra_6x11_iso8859_1 does not match the font");
+static_assert(matches<FontTags::bitocra_7x13_iso8859_1>(raw::_fonts_bitocra_7x13_iso8859_1_info), "Font tag bitocra_7x13_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_6x12_iso8859_1>(raw::_fonts_terminus_6x12_iso8859_1_info), "Font tag terminus_6x12_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_8x14_iso8859_1>(raw::_fonts_terminus_8x14_iso8859_1_info), "Font tag terminus_8x14_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_10x18_iso8859_1>(raw::_fonts_terminus_10x18_iso8859_1_info), "Font tag terminus_10x18_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_11x22_iso8859_1>(raw::_fonts_terminus_11x22_iso8859_1_info), "Font tag terminus_11x22_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_12x24_iso8859_1>(raw::_fonts_terminus_12x24_iso8859_1_info), "Font tag terminus_12x24_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_14x28_iso8859_1>(raw::_fonts_terminus_14x28_iso8859_1_info), "Font tag terminus_14x28_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_16x32_iso8859_1>(raw::_fonts_terminus_16x32_iso8859_1_info), "Font tag terminus_16x32_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_bold_8x14_iso8859_1>(raw::_fonts_terminus_bold_8x14_iso8859_1_info), "Font tag terminus_bold_8x14_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_bold_10x18_iso8859_1>(raw::_fonts_terminus_bold_10x18_iso8859_1_info), "Font tag terminus_bold_10x18_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_bold_11x22_iso8859_1>(raw::_fonts_terminus_bold_11x22_iso8859_1_info), "Font tag terminus_bold_11x22_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_bold_12x24_iso8859_1>(raw::_fonts_terminus_bold_12x24_iso8859_1_info), "Font tag terminus_bold_12x24_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_bold_14x28_iso8859_1>(raw::_fonts_terminus_bold_14x28_iso8859_1_info), "Font tag terminus_bold_14x28_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_bold_16x32_iso8859_1>(raw::_fonts_terminus_bold_16x32_iso8859_1_info), "Font tag terminus_bold_16x32_iso8859_1 does not match the font");
+static_assert(matches<FontTags::terminus_6x12_koi8_r>(raw::_fonts_terminus_6x12_koi8_r_info), "Font tag terminus_6x12_koi8_r does not match the font");
+static_assert(matches<FontTags::terminus_8x14_koi8_r>(raw::_fonts_terminus_8x14_koi8_r_info), "Font tag terminus_8x14_koi8_r does not match the font");
+static_assert(matches<FontTags::terminus_14x28_koi8_r>(raw::_fonts_terminus_14x28_koi8_r_info), "Font tag terminus_14x28_koi8_r does not match the font");
+static_assert(matches<FontTags::terminus_16x32_koi8_r>(raw::_fonts_terminus_16x32_koi8_r_info), "Font tag terminus_16x32_koi8_r does not match the font");
+static_assert(matches<FontTags::terminus_bold_8x14_koi8_r>(raw::_fonts_terminus_bold_8x14_koi8_r_info), "Font tag terminus_bold_8x14_koi8_r does not match the font");
+static_assert(matches<FontTags::terminus_bold_14x28_koi8_r>(raw::_fonts_terminus_bold_14x28_koi8_r_info), "Font tag terminus_bold_14x28_koi8_r does not match the font");
+static_assert(matches<FontTags::terminus_bold_16x32_koi8_r>(raw::_fonts_terminus_bold_16x32_koi8_r_info), "Font tag terminus_bold_16x32_koi8_r does not match the font");
+
+/**
+ * @brief The engines of a font, LRTB and PTBLR, or nullptr when the font is baked compressed
+ *
+ * Compressed fonts are rasterized a glyph at a time and have no bitmap for the
+ * engines to read, so theirs are not instantiated.
+ */
+template <typename Font, const font_info_t &Raw, bool Compressed = bakeFont(RASTERFONT_COMPRESSED_FONTS, Raw.name)>
+struct Engines
+{
+    static constexpr FontEngine value[2] = {
+        {StaticFontManager<Font, FontManager::LRTB>::MeasureString, StaticFontManager<Font, FontManager::LRTB>::RasterString},
+        {StaticFontManager<Font, FontManager::PTBLR>::MeasureString, StaticFontManager<Font, FontManager::PTBLR>::RasterString},
+    };
+};
+
+template <typename Font, const font_info_t &Raw>
+struct Engines<Font, Raw, true>
+{
+    static constexpr const FontEngine *value = nullptr;
+};
+
+const FontEngine *const font_engines[NUM_FONTS] = {
+    Engines<FontTags::glcd_5x7, raw::_fonts_glcd_5x7_info>::value,
+#ifdef FONTS_ASCII
+    /*
+     * ascii fonts
+     */
+    Engines<FontTags::bitocra_4x7_ascii, raw::_fonts_bitocra_4x7_ascii_info>::value,
+    Engines<FontTags::roboto_8pt_ascii, raw::_fonts_roboto_8pt_ascii_info>::value,
+    Engines<FontTags::roboto_10pt_ascii, raw::_fonts_roboto_10pt_ascii_info>::value,
+    Engines<FontTags::tahoma_8pt_ascii, raw::_font_tahoma_8pt_ascii_info>::value,
+#endif
+#ifdef FONTS_ISO8859
+    /*
+     * iso8859_1 fonts
+     */
+    Engines<FontTags::bitocra_6x11_iso8859_1, raw::_fonts_bitocra_6x11_iso8859_1_info>::value,
+    Engines<FontTags::bitocra_7x13_iso8859_1, raw::_fonts_bitocra_7x13_iso8859_1_info>::value,
+    Engines<FontTags::terminus_6x12_iso8859_1, raw::_fonts_terminus_6x12_iso8859_1_info>::value,
+    Engines<FontTags::terminus_8x14_iso8859_1, raw::_fonts_terminus_8x14_iso8859_1_info>::value,
+    Engines<FontTags::terminus_10x18_iso8859_1, raw::_fonts_terminus_10x18_iso8859_1_info>::value,
+    Engines<FontTags::terminus_11x22_iso8859_1, raw::_fonts_terminus_11x22_iso8859_1_info>::value,
+    Engines<FontTags::terminus_12x24_iso8859_1, raw::_fonts_terminus_12x24_iso8859_1_info>::value,
+    Engines<FontTags::terminus_14x28_iso8859_1, raw::_fonts_terminus_14x28_iso8859_1_info>::value,
+    Engines<FontTags::terminus_16x32_iso8859_1, raw::_fonts_terminus_16x32_iso8859_1_info>::value,
+    Engines<FontTags::terminus_bold_8x14_iso8859_1, raw::_fonts_terminus_bold_8x14_iso8859_1_info>::value,
+    Engines<FontTags::terminus_bold_10x18_iso8859_1, raw::_fonts_terminus_bold_10x18_iso8859_1_info>::value,
+    Engines<FontTags::terminus_bold_11x22_iso8859_1, raw::_fonts_terminus_bold_11x22_iso8859_1_info>::value,
+    Engines<FontTags::terminus_bold_12x24_iso8859_1, raw::_fonts_terminus_bold_12x24_iso8859_1_info>::value,
+    Engines<FontTags::terminus_bold_14x28_iso8859_1, raw::_fonts_terminus_bold_14x28_iso8859_1_info>::value,
+    Engines<FontTags::terminus_bold_16x32_iso8859_1, raw::_fonts_terminus_bold_16x32_iso8859_1_info>::value,
+#endif
+#ifdef FONTS_KOI8
+    /*
+     * koi8_r fonts
+     */
+    Engines<FontTags::terminus_6x12_koi8_r, raw::_fonts_terminus_6x12_koi8_r_info>::value,
+    Engines<FontTags::terminus_8x14_koi8_r, raw::_fonts_terminus_8x14_koi8_r_info>::value,
+    Engines<FontTags::terminus_14x28_koi8_r, raw::_fonts_terminus_14x28_koi8_r_info>::value,
+    Engines<FontTags::terminus_16x32_koi8_r, raw::_fonts_terminus_16x32_koi8_r_info>::value,
+    Engines<FontTags::terminus_bold_8x14_koi8_r, raw::_fonts_terminus_bold_8x14_koi8_r_info>::value,
+    Engines<FontTags::terminus_bold_14x28_koi8_r, raw::_fonts_terminus_bold_14x28_koi8_r_info>::value,
+    Engines<FontTags::terminus_bold_16x32_koi8_r, raw::_fonts_terminus_bold_16x32_koi8_r_info>::value
+#endif
+};
+
+} // namespace
+
+/**
+ * @brief The engine for a font and raster
+ *
+ * @param fontIndex the font
+ * @param raster the raster direction
+ * @return the font's engine, nullptr for the rasters and compressed fonts without engines
+ */
+const FontEngine *FontEngineFor(uint8_t fontIndex, FontManager::Raster raster)
+{
+    if (raster != FontManager::LRTB && raster != FontManager::PTBLR)
+        return nullptr; // Rasterized by the generic character path
+    if (!font_engines[fontIndex]) // Err out if out of bounds
+        return nullptr; // Compressed, rasterized a glyph at a time
+    return &font_engines[fontIndex][raster];
+} // FontEngineFor
+
+/**
+ * @brief The baked paged raster of a font
+ *
+ * @param font the font
+ * @return the paged raster, nullptr if the font is not baked
+ */
+const paged_font_info_t *PagedFontOf(const font_info_t *font)
+{
+    for (uint8_t i = 0; i < NUM_FONTS; i++)
+    {
+        if (fonts[i] == font)
+            return paged_fonts[i];
+    }
+    return nullptr;
+} // PagedFontOf
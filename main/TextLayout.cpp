@@ -0,0 +1,239 @@
+/*
+ Raster-Font Library Text Layout
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "TextLayout.h"
+
+/**
+ * @brief Is the character a space lines can break at
+ */
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t';
+} // isSpace
+
+/**
+ * @brief Instantiates a layout in the font
+ *
+ * @param fm the font manager of the font to measure in, referenced for the life of the layout when UTF-8
+ */
+TextLayout::TextLayout(FontManager &fm) : m_advances{fm}
+{
+} // TextLayout
+
+/**
+ * @brief The width of a line from the start of one box to the end of another
+ */
+uint32_t TextLayout::Width(const Box &first, const Box &last) const
+{
+    return m_offset[last.end - m_base] - m_offset[first.begin - m_base];
+} // Width
+
+/**
+ * @brief Adds a box to the paragraph, broken between characters if wider than a line
+ *
+ * An indented box wider than a line loses its indentation first.
+ *
+ * @param text the text
+ * @param begin the first character
+ * @param end one past the last character
+ * @param pixels the line width
+ */
+void TextLayout::AddBox(std::string_view text, uint32_t begin, uint32_t end, uint16_t pixels)
+{
+    if (m_offset[end - m_base] - m_offset[begin - m_base] > pixels)
+    {
+        while (isSpace(text[begin]))
+        {
+            begin++;
+        }
+    }
+
+    uint32_t piece = begin;
+
+    for (uint32_t c = begin + 1; c < end; c++)
+    /*
+     * Break before a character that would overrun the line, a character wider than a line standing alone
+     */
+    {
+        if (!m_advances.Continues(text[c]) && m_offset[c + 1 - m_base] - m_offset[piece - m_base] > pixels)
+        {
+            m_boxes.push_back({piece, c});
+            piece = c;
+        }
+    }
+    m_boxes.push_back({piece, end});
+} // AddBox
+
+/**
+ * @brief Measures a paragraph and splits it into boxes
+ *
+ * Boxes end before spaces and after hyphens that join two parts of a word.
+ * Leading spaces stay with the first box, as indentation.
+ *
+ * @param text the text
+ * @param begin the first character of the paragraph
+ * @param end one past the last character of the paragraph
+ * @param pixels the line width
+ */
+void TextLayout::Boxes(std::string_view text, uint32_t begin, uint32_t end, uint16_t pixels)
+{
+    m_base = begin;
+    m_boxes.clear();
+    m_offset.resize(end - begin + 1);
+
+    m_offset[0] = 0;
+    m_advances.Offsets(text.substr(begin, end - begin), 0, m_offset.data() + 1);
+
+    uint32_t i = begin;
+    uint32_t start = begin;
+    while (i < end && isSpace(text[i]))
+    {
+        i++;
+    }
+
+    while (i < end)
+    {
+        while (i < end && !isSpace(text[i]))
+        {
+            i++;
+            if (text[i - 1] == '-' && (i - 1) > start && text[i - 2] != '-' && i < end && !isSpace(text[i]))
+            /*
+             * Break opportunity after a hyphen inside a word
+             */
+            {
+                AddBox(text, start, i, pixels);
+                start = i;
+            }
+        }
+        if (i > start)
+            AddBox(text, start, i, pixels);
+
+        while (i < end && isSpace(text[i]))
+        {
+            i++;
+        }
+        start = i;
+    }
+} // Boxes
+
+/**
+ * @brief Fills each line with as many boxes as fit
+ *
+ * @param lines the lines to append to
+ * @param pixels the line width
+ */
+void TextLayout::Greedy(std::vector<Line> &lines, uint16_t pixels)
+{
+    size_t first = 0;
+
+    for (size_t next = 1; next <= m_boxes.size(); next++)
+    {
+        if (next == m_boxes.size() || Width(m_boxes[first], m_boxes[next]) > pixels)
+        {
+            lines.push_back({m_boxes[first].begin, m_boxes[next - 1].end, Width(m_boxes[first], m_boxes[next - 1])});
+            first = next;
+        }
+    }
+} // Greedy
+
+/**
+ * @brief Breaks the paragraph where the sum of the squared slack of its lines, but the last, is least
+ *
+ * Dynamic programming over the boxes; the lines ending at a box are only tried
+ * back to the first box that overruns, so the work is linear in the boxes times
+ * the boxes on a line.
+ *
+ * @param lines the lines to append to
+ * @param pixels the line width
+ */
+void TextLayout::MinRaggedness(std::vector<Line> &lines, uint16_t pixels)
+{
+    size_t count = m_boxes.size();
+
+    m_cost.assign(count + 1, UINT64_MAX);
+    m_from.assign(count + 1, 0);
+    m_cost[0] = 0;
+
+    for (size_t last = 1; last <= count; last++)
+    /*
+     * Least cost of the boxes before last, ending a line at box last - 1
+     */
+    {
+        for (size_t first = last; first-- > 0;)
+        {
+            uint32_t width = Width(m_boxes[first], m_boxes[last - 1]);
+            if (width > pixels && first < last - 1)
+                break;
+
+            uint64_t slack = (width < pixels) ? pixels - width : 0;
+            uint64_t cost = m_cost[first] + ((last == count) ? 0 : slack * slack);
+            if (cost < m_cost[last])
+            {
+                m_cost[last] = cost;
+                m_from[last] = first;
+            }
+        }
+    }
+
+    size_t at = lines.size();
+    for (size_t last = count; last > 0; last = m_from[last])
+    {
+        size_t first = m_from[last];
+        lines.push_back({m_boxes[first].begin, m_boxes[last - 1].end, Width(m_boxes[first], m_boxes[last - 1])});
+    }
+    std::reverse(lines.begin() + at, lines.end());
+} // MinRaggedness
+
+/**
+ * @brief Wraps text into lines
+ *
+ * Newlines end paragraphs, a carriage return before one being dropped, and a
+ * paragraph with no words is an empty line.
+ *
+ * @param text the text
+ * @param pixels the line width
+ * @param mode how lines are filled
+ * @return the lines in order, as character spans of the text
+ */
+std::vector<TextLayout::Line> TextLayout::Wrap(std::string_view text, uint16_t pixels, Mode mode)
+{
+    std::vector<Line> lines;
+    uint32_t begin = 0;
+
+    while (begin < text.size())
+    {
+        size_t newline = text.find('\n', begin);
+        uint32_t next = (newline == std::string_view::npos) ? text.size() : newline + 1;
+        uint32_t end = (newline == std::string_view::npos) ? text.size() : newline;
+        if (end > begin && text[end - 1] == '\r')
+            end--;
+
+        Boxes(text, begin, end, pixels);
+        if (m_boxes.empty())
+            lines.push_back({begin, begin, 0});
+        else if (mode == MIN_RAGGEDNESS)
+            MinRaggedness(lines, pixels);
+        else
+            Greedy(lines, pixels);
+
+        begin = next;
+    }
+    return lines;
+} // Wrap
@@ -0,0 +1,190 @@
+/*
+ Raster-Font Library Work Stealing Pool
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include "WorkStealingPool.h"
+
+/**
+ * @brief Starts the worker threads
+ *
+ * @param threads the number of workers, 0 for one per hardware thread
+ */
+WorkStealingPool::WorkStealingPool(unsigned threads)
+{
+    if (!threads)
+        threads = std::thread::hardware_concurrency();
+    if (!threads)
+        threads = 1;
+
+    for (unsigned i = 0; i < threads; i++)
+    {
+        m_queues.emplace_back(new Queue);
+    }
+    for (unsigned i = 0; i < threads; i++)
+    {
+        m_threads.emplace_back(&WorkStealingPool::Work, this, i);
+    }
+} // WorkStealingPool
+
+/**
+ * @brief Stops and joins the worker threads
+ */
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &thread : m_threads)
+    {
+        thread.join();
+    }
+} // ~WorkStealingPool
+
+/**
+ * @brief The number of workers
+ *
+ * @return worker count
+ */
+unsigned WorkStealingPool::Threads() const
+{
+    return m_threads.size();
+} // Threads
+
+/**
+ * @brief The number of tasks run by a worker other than the one they were queued to
+ *
+ * @return steals since the pool started
+ */
+uint64_t WorkStealingPool::Steals() const
+{
+    return m_steals;
+} // Steals
+
+/**
+ * @brief Runs task 0 to count-1 across the workers, returning when all are complete
+ *
+ * Tasks are queued to the workers in contiguous runs. Not reentrant; tasks must not
+ * call ParallelFor on the same pool.
+ *
+ * @param count the number of tasks
+ * @param task the task body, given the task and worker indices
+ */
+void WorkStealingPool::ParallelFor(size_t count, const Task &task)
+{
+    if (!count)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_pending = count;
+
+        size_t workers = m_queues.size();
+        for (size_t w = 0; w < workers; w++)
+        {
+            std::lock_guard<std::mutex> queue_lock(m_queues[w]->mutex);
+            for (size_t t = (count * w) / workers; t < (count * (w + 1)) / workers; t++)
+            {
+                m_queues[w]->tasks.push_back(t);
+            }
+        }
+        m_generation++;
+    }
+    m_wake.notify_all();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending == 0; });
+    m_task = nullptr;
+} // ParallelFor
+
+/**
+ * @brief Takes a task from the worker's own queue, or steals one
+ *
+ * @param worker the worker
+ * @param task set to the task taken
+ * @return false if there are no tasks left in any queue
+ */
+bool WorkStealingPool::Take(unsigned worker, size_t &task)
+{
+    {
+        Queue &own = *m_queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < m_queues.size(); i++)
+    /*
+     * Steal the oldest task of the next worker with any
+     */
+    {
+        Queue &victim = *m_queues[(worker + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            m_steals++;
+            return true;
+        }
+    }
+    return false;
+} // Take
+
+/**
+ * @brief Worker thread body, running tasks of each generation until stopped
+ *
+ * @param worker the worker
+ */
+void WorkStealingPool::Work(unsigned worker)
+{
+    uint64_t generation = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != generation; });
+            if (m_stop)
+                return;
+            generation = m_generation;
+        }
+
+        size_t index;
+        while (Take(worker, index))
+        /*
+         * The body is read per task, as a task taken here may already be of the next generation
+         */
+        {
+            (*m_task.load())(index, worker);
+            if (m_pending.fetch_sub(1) == 1)
+            /*
+             * Last task of the generation
+             */
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_done.notify_all();
+            }
+        }
+    }
+} // Work
@@ -7,6 +7,11 @@
 
 #include "fonts.h"
 
+/*
+ * With fonts baked compressed the tables are defined by CompressedFonts.cpp
+ */
+#if !RASTERFONT_COMPRESSED_TABLES
+
 #include "font_bitocra_4x7_ascii.h"
 #include "font_bitocra_6x11_iso8859_1.h"
 #include "font_bitocra_7x13_iso8859_1.h"
@@ -80,3 +85,5 @@ const font_info_t * fonts [ NUM_FONTS ] = {
         &_fonts_terminus_bold_16x32_koi8_r_info
 #endif
     };
+
+#endif /* RASTERFONT_COMPRESSED_TABLES */
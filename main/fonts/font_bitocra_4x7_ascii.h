@@ -14,7 +14,7 @@
 #ifndef _EXTRAS_FONTS_FONT_BITOCRA_4X7_ASCII_H_
 #define _EXTRAS_FONTS_FONT_BITOCRA_4X7_ASCII_H_
 
-static const uint8_t _fonts_bitocra_4x7_ascii_bitmaps [] = {
+static FONT_DATA uint8_t _fonts_bitocra_4x7_ascii_bitmaps [] = {
 
 /* Index: 0x00, char: \x20, offset: 0x0000 */
 0x00, /* ........ */
@@ -881,7 +881,7 @@ static const uint8_t _fonts_bitocra_4x7_ascii_bitmaps [] = {
 0x00, /* ........ */
 };
 
-const font_char_desc_t _fonts_bitocra_4x7_ascii_descriptors [] = {
+FONT_DATA font_char_desc_t _fonts_bitocra_4x7_ascii_descriptors [] = {
 { 0x04, 0x0000 }, /* Index: 0x00, char: \x20 */
 { 0x04, 0x0007 }, /* Index: 0x01, char: \x21 */
 { 0x04, 0x000e }, /* Index: 0x02, char: \x22 */
@@ -980,7 +980,7 @@ const font_char_desc_t _fonts_bitocra_4x7_ascii_descriptors [] = {
 { 0x04, 0x0299 }, /* Index: 0x5f, char: \x7f */
 };
 
-const font_info_t _fonts_bitocra_4x7_ascii_info = {    //
+FONT_DATA font_info_t _fonts_bitocra_4x7_ascii_info = {    //
         .name = "bitocra_4x7_ascii",    //
                 .height = 7, /* Character height */
                 .c = 0, /* C */
@@ -14,7 +14,7 @@
 #ifndef _EXTRAS_FONTS_FONT_BITOCRA_6X11_ISO8859_1_H_
 #define _EXTRAS_FONTS_FONT_BITOCRA_6X11_ISO8859_1_H_
 
-static const uint8_t _fonts_bitocra_6x11_iso8859_1_bitmaps [] = {
+static FONT_DATA uint8_t _fonts_bitocra_6x11_iso8859_1_bitmaps [] = {
 
 /* Index: 0x00, char: \x20, offset: 0x0000 */
 0x00, /* ........ */
@@ -2929,7 +2929,7 @@ static const uint8_t _fonts_bitocra_6x11_iso8859_1_bitmaps [] = {
 0x00, /* ........ */
 };
 
-const font_char_desc_t _fonts_bitocra_6x11_iso8859_1_descriptors [] = {
+FONT_DATA font_char_desc_t _fonts_bitocra_6x11_iso8859_1_descriptors [] = {
 { 0x06, 0x0000 }, /* Index: 0x00, char: \x20 */
 { 0x06, 0x000b }, /* Index: 0x01, char: \x21 */
 { 0x06, 0x0016 }, /* Index: 0x02, char: \x22 */
@@ -3156,7 +3156,7 @@ const font_char_desc_t _fonts_bitocra_6x11_iso8859_1_descriptors [] = {
 { 0x06, 0x0995 }, /* Index: 0xdf, char: \xff */
 };
 
-const font_info_t _fonts_bitocra_6x11_iso8859_1_info = {    //
+FONT_DATA font_info_t _fonts_bitocra_6x11_iso8859_1_info = {    //
         .name = "bitocra_6x11_iso8859_1",    //
                 .height = 11, /* Character height */
                 .c = 0, /* C */
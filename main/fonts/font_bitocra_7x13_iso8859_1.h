@@ -14,7 +14,7 @@
 #ifndef _EXTRAS_FONTS_FONT_BITOCRA_7X13_ISO8859_1_H_
 #define _EXTRAS_FONTS_FONT_BITOCRA_7X13_ISO8859_1_H_
 
-static const uint8_t _fonts_bitocra_7x13_iso8859_1_bitmaps [] = {
+static FONT_DATA uint8_t _fonts_bitocra_7x13_iso8859_1_bitmaps [] = {
 
 /* Index: 0x00, char: \x20, offset: 0x0000 */
 0x00, /* ........ */
@@ -3377,7 +3377,7 @@ static const uint8_t _fonts_bitocra_7x13_iso8859_1_bitmaps [] = {
 0xf8, /* #####... */
 };
 
-const font_char_desc_t _fonts_bitocra_7x13_iso8859_1_descriptors [] = {
+FONT_DATA font_char_desc_t _fonts_bitocra_7x13_iso8859_1_descriptors [] = {
 { 0x07, 0x0000 }, /* Index: 0x00, char: \x20 */
 { 0x07, 0x000d }, /* Index: 0x01, char: \x21 */
 { 0x07, 0x001a }, /* Index: 0x02, char: \x22 */
@@ -3604,7 +3604,7 @@ const font_char_desc_t _fonts_bitocra_7x13_iso8859_1_descriptors [] = {
 { 0x07, 0x0b53 }, /* Index: 0xdf, char: \xff */
 };
 
-const font_info_t _fonts_bitocra_7x13_iso8859_1_info = { .name = "bitocra_7x13_iso8859_1", .height = 13, /* Character height */
+FONT_DATA font_info_t _fonts_bitocra_7x13_iso8859_1_info = { .name = "bitocra_7x13_iso8859_1", .height = 13, /* Character height */
 .c = 0, /* C */
 .char_start = 32, /* Start character */
 .char_end = 255, /* End character */
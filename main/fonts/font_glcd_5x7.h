@@ -39,7 +39,7 @@
 #ifndef _EXTRAS_FONTS_FONT_GLCD_5X7_H_
 #define _EXTRAS_FONTS_FONT_GLCD_5X7_H_
 
-static const uint8_t _fonts_glcd_5x7_bitmaps [ ] =
+static FONT_DATA uint8_t _fonts_glcd_5x7_bitmaps [ ] =
 {
         /* @0 '\x0' (5 pixels wide) */
         0x00, //
@@ -2349,7 +2349,7 @@ static const uint8_t _fonts_glcd_5x7_bitmaps [ ] =
 
 /* Character descriptors for glcd 5x7 */
 /* { [Char width in bits], [Offset into glcd_5x7_bitmaps in bytes] } */
-const font_char_desc_t _fonts_glcd_5x7_descriptors[] =
+FONT_DATA font_char_desc_t _fonts_glcd_5x7_descriptors[] =
 {
         {5, 0},     /* \x00 */
         {5, 7},     /* \x01 */
@@ -2611,7 +2611,7 @@ const font_char_desc_t _fonts_glcd_5x7_descriptors[] =
 
 /* Font information for glcd 5x7 */
 
-const font_info_t _fonts_glcd_5x7_info =
+FONT_DATA font_info_t _fonts_glcd_5x7_info =
 {
     .name             = "glcd_5x7",
     .height           = 7,                           /* Character height */
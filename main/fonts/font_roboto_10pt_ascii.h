@@ -9,7 +9,7 @@
 #define _EXTRAS_FONTS_FONT_ROBOTO_10PT_H_
 
 // Character bitmaps for Roboto 10pt
-const uint8_t _fonts_roboto_10pt_bitmaps[] =
+FONT_DATA uint8_t _fonts_roboto_10pt_bitmaps[] =
 {
 	// @0 '!' (1 pixels wide)
 	0x00, //  
@@ -1518,7 +1518,7 @@ const uint8_t _fonts_roboto_10pt_bitmaps[] =
 
 // Character descriptors for Roboto 10pt
 // { [Char width in bits], [Offset into roboto_10ptCharBitmaps in bytes] }
-const font_char_desc_t _fonts_roboto_10pt_descriptors[] =
+FONT_DATA font_char_desc_t _fonts_roboto_10pt_descriptors[] =
 {
 	{1, 0}, 		// ! 
 	{3, 14}, 		// " 
@@ -1617,13 +1617,13 @@ const font_char_desc_t _fonts_roboto_10pt_descriptors[] =
 };
 
 // Font information for Roboto 10pt
-const font_info_t _fonts_roboto_10pt_ascii_info =
+FONT_DATA font_info_t _fonts_roboto_10pt_ascii_info =
 {
     .name             = "roboto_10pt_ascii",
     .height           = 14,                              //  Character height
+    .c                = 2,                             //  Width, in pixels, of space character
     .char_start       = '!',                           //  Start character
     .char_end         = '~',                           //  End character
-    .c                = 2,                             //  Width, in pixels, of space character
     .char_descriptors = _fonts_roboto_10pt_descriptors, //  Character descriptor array
     .bitmap           = _fonts_roboto_10pt_bitmaps,     //  Character bitmap array
 };
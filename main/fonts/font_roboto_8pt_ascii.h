@@ -9,7 +9,7 @@
 #define _EXTRAS_FONTS_FONT_ROBOTO_8PT_H_
 
 // Character bitmaps for Roboto 8pt
-const uint8_t _fonts_roboto_8pt_bitmaps[] =
+FONT_DATA uint8_t _fonts_roboto_8pt_bitmaps[] =
 {
 	// @0 '!' (1 pixels wide)
 	0x00, //  
@@ -1236,7 +1236,7 @@ const uint8_t _fonts_roboto_8pt_bitmaps[] =
 
 // Character descriptors for Roboto 8pt
 // { [Char width in bits], [Offset into roboto_8ptCharBitmaps in bytes] }
-const font_char_desc_t _fonts_roboto_8pt_descriptors[] =
+FONT_DATA font_char_desc_t _fonts_roboto_8pt_descriptors[] =
 {
 	{1, 0}, 		// ! 
 	{2, 11}, 		// " 
@@ -1335,13 +1335,13 @@ const font_char_desc_t _fonts_roboto_8pt_descriptors[] =
 };
 
 // Font information for Roboto 8pt
-const font_info_t _fonts_roboto_8pt_ascii_info =
+FONT_DATA font_info_t _fonts_roboto_8pt_ascii_info =
 {
     .name             = "roboto_8pt_ascii",
     .height           = 11,                            //  Character height
+    .c                = 2,                             //  Width, in pixels, of space character
     .char_start       = '!',                           //  Start character
     .char_end         = '~',                           //  End character
-    .c                = 2,                             //  Width, in pixels, of space character
     .char_descriptors = _fonts_roboto_8pt_descriptors, //  Character descriptor array
     .bitmap           = _fonts_roboto_8pt_bitmaps,     //  Character bitmap array
 };
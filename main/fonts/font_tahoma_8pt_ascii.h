@@ -12,7 +12,7 @@
  */
 
 /* Character bitmaps for Tahoma 8pt */
-static const uint8_t tahoma_8pt_bitmaps [] = {
+static FONT_DATA uint8_t tahoma_8pt_bitmaps [] = {
 /* @0 ' ' (1 pixels wide) */
 0x00,    //
         0x00,    //
@@ -1251,7 +1251,7 @@ static const uint8_t tahoma_8pt_bitmaps [] = {
 
 /* Character descriptors for Tahoma 8pt */
 /* { [Char width in bits], [Offset into tahoma_8ptCharBitmaps in bytes] } */
-const font_char_desc_t tahoma_descriptors [] = {   
+FONT_DATA font_char_desc_t tahoma_descriptors [] = {   
                 { 1, 11 }, /* ! */
                 { 3, 22 }, /* " */
                 { 7, 33 }, /* # */
@@ -1348,7 +1348,7 @@ const font_char_desc_t tahoma_descriptors [] = {
                 { 7, 1067 }, /* ~ */
         };
 
-const font_info_t _font_tahoma_8pt_ascii_info = {    //
+FONT_DATA font_info_t _font_tahoma_8pt_ascii_info = {    //
         .name = "tahoma_8pt_ascii",    //
                 .height = 11, /* Character height */
                 .c = 1, /* C */
@@ -15,7 +15,7 @@
 #ifndef _EXTRAS_FONTS_FONT_TERMINUS_10X18_ISO8859_1_H_
 #define _EXTRAS_FONTS_FONT_TERMINUS_10X18_ISO8859_1_H_
 
-static const uint8_t _fonts_terminus_10x18_iso8859_1_bitmaps [] = {
+static FONT_DATA uint8_t _fonts_terminus_10x18_iso8859_1_bitmaps [] = {
 
 /* Index: 0x00, char: \x01, offset: 0x0000 */
 0x00, 0x00, /* ................ */
@@ -5118,7 +5118,7 @@ static const uint8_t _fonts_terminus_10x18_iso8859_1_bitmaps [] = {
 0x3e, 0x00, /* ..#####......... */
 };
 
-const font_char_desc_t _fonts_terminus_10x18_iso8859_1_descriptors [] = {    //
+FONT_DATA font_char_desc_t _fonts_terminus_10x18_iso8859_1_descriptors [] = {    //
         { 0x0a, 0x0000 }, /* Index: 0x00, char: \x01 */
         { 0x0a, 0x0024 }, /* Index: 0x01, char: \x02 */
         { 0x0a, 0x0048 }, /* Index: 0x02, char: \x03 */
@@ -5376,7 +5376,7 @@ const font_char_desc_t _fonts_terminus_10x18_iso8859_1_descriptors [] = {    //
         { 0x0a, 0x23b8 }, /* Index: 0xfe, char: \xff */
         };
 
-const font_info_t _fonts_terminus_10x18_iso8859_1_info = { .name = "terminus_10x18_iso8859_1", .height = 18, /* Character height */
+FONT_DATA font_info_t _fonts_terminus_10x18_iso8859_1_info = { .name = "terminus_10x18_iso8859_1", .height = 18, /* Character height */
 .c = 0, /* C */
 .char_start = 1, /* Start character */
 .char_end = 255, /* End character */
@@ -15,7 +15,7 @@
 #ifndef _EXTRAS_FONTS_FONT_TERMINUS_14X28_KOI8_R_H_
 #define _EXTRAS_FONTS_FONT_TERMINUS_14X28_KOI8_R_H_
 
-static const uint8_t _fonts_terminus_14x28_koi8_r_bitmaps [] = {
+static FONT_DATA uint8_t _fonts_terminus_14x28_koi8_r_bitmaps [] = {
 
 /* Index: 0x00, char: \x01, offset: 0x0000 */
 0x00, 0x00, /* ................ */
@@ -7668,7 +7668,7 @@ static const uint8_t _fonts_terminus_14x28_koi8_r_bitmaps [] = {
 0x00, 0x00, /* ................ */
 };
 
-const font_char_desc_t _fonts_terminus_14x28_koi8_r_descriptors [] = {
+FONT_DATA font_char_desc_t _fonts_terminus_14x28_koi8_r_descriptors [] = {
 { 0x0e, 0x0000 }, /* Index: 0x00, char: \x01 */
 { 0x0e, 0x0038 }, /* Index: 0x01, char: \x02 */
 { 0x0e, 0x0070 }, /* Index: 0x02, char: \x03 */
@@ -7926,7 +7926,7 @@ const font_char_desc_t _fonts_terminus_14x28_koi8_r_descriptors [] = {
 { 0x0e, 0x3790 }, /* Index: 0xfe, char: \xff */
 };
 
-const font_info_t _fonts_terminus_14x28_koi8_r_info = {    //
+FONT_DATA font_info_t _fonts_terminus_14x28_koi8_r_info = {    //
         .name = "terminus_14x28_koi8_r",    //
                 .height = 28, /* Character height */
                 .c = 0, /* C */
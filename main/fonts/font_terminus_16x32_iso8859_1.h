@@ -15,7 +15,7 @@
 #ifndef _EXTRAS_FONTS_FONT_TERMINUS_16X32_ISO8859_1_H_
 #define _EXTRAS_FONTS_FONT_TERMINUS_16X32_ISO8859_1_H_
 
-static const uint8_t _fonts_terminus_16x32_iso8859_1_bitmaps [] = {
+static FONT_DATA uint8_t _fonts_terminus_16x32_iso8859_1_bitmaps [] = {
 
 /* Index: 0x00, char: \x01, offset: 0x0000 */
 0x00, 0x00, /* ................ */
@@ -8688,7 +8688,7 @@ static const uint8_t _fonts_terminus_16x32_iso8859_1_bitmaps [] = {
 0x00, 0x00, /* ................ */
 };
 
-const font_char_desc_t _fonts_terminus_16x32_iso8859_1_descriptors [] = {
+FONT_DATA font_char_desc_t _fonts_terminus_16x32_iso8859_1_descriptors [] = {
 { 0x10, 0x0000 }, /* Index: 0x00, char: \x01 */
 { 0x10, 0x0040 }, /* Index: 0x01, char: \x02 */
 { 0x10, 0x0080 }, /* Index: 0x02, char: \x03 */
@@ -8946,7 +8946,7 @@ const font_char_desc_t _fonts_terminus_16x32_iso8859_1_descriptors [] = {
 { 0x10, 0x3f80 }, /* Index: 0xfe, char: \xff */
 };
 
-const font_info_t _fonts_terminus_16x32_iso8859_1_info = { .name = "terminus_16x32_iso8859_1",    //
+FONT_DATA font_info_t _fonts_terminus_16x32_iso8859_1_info = { .name = "terminus_16x32_iso8859_1",    //
         .height = 32, /* Character height */
         .c = 0, /* C */
         .char_start = 1, /* Start character */
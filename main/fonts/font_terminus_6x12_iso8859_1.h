@@ -15,7 +15,7 @@
 #ifndef _EXTRAS_FONTS_FONT_TERMINUS_6X12_ISO8859_1_H_
 #define _EXTRAS_FONTS_FONT_TERMINUS_6X12_ISO8859_1_H_
 
-static const uint8_t _fonts_terminus_6x12_iso8859_1_bitmaps [] = {
+static FONT_DATA uint8_t _fonts_terminus_6x12_iso8859_1_bitmaps [] = {
 
 /* Index: 0x00, char: \x01, offset: 0x0000 */
 0x00, /* ........ */
@@ -3588,7 +3588,7 @@ static const uint8_t _fonts_terminus_6x12_iso8859_1_bitmaps [] = {
 0x70, /* .###.... */
 };
 
-const font_char_desc_t _fonts_terminus_6x12_iso8859_1_descriptors [] = {
+FONT_DATA font_char_desc_t _fonts_terminus_6x12_iso8859_1_descriptors [] = {
 { 0x06, 0x0000 }, /* Index: 0x00, char: \x01 */
 { 0x06, 0x000c }, /* Index: 0x01, char: \x02 */
 { 0x06, 0x0018 }, /* Index: 0x02, char: \x03 */
@@ -3846,7 +3846,7 @@ const font_char_desc_t _fonts_terminus_6x12_iso8859_1_descriptors [] = {
 { 0x06, 0x0be8 }, /* Index: 0xfe, char: \xff */
 };
 
-const font_info_t _fonts_terminus_6x12_iso8859_1_info = {    //
+FONT_DATA font_info_t _fonts_terminus_6x12_iso8859_1_info = {    //
         .name = "terminus_6x12_iso8859_1",    //
                 .height = 12, /* Character height */
                 .c = 0, /* C */
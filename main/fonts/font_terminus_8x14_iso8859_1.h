@@ -15,7 +15,7 @@
 #ifndef _EXTRAS_FONTS_FONT_TERMINUS_8X14_ISO8859_1_H_
 #define _EXTRAS_FONTS_FONT_TERMINUS_8X14_ISO8859_1_H_
 
-static const uint8_t _fonts_terminus_8x14_iso8859_1_bitmaps [] = {
+static FONT_DATA uint8_t _fonts_terminus_8x14_iso8859_1_bitmaps [] = {
 
 /* Index: 0x00, char: \x01, offset: 0x0000 */
 0x00, /* ........ */
@@ -4098,7 +4098,7 @@ static const uint8_t _fonts_terminus_8x14_iso8859_1_bitmaps [] = {
 0x3c, /* ..####.. */
 };
 
-const font_char_desc_t _fonts_terminus_8x14_iso8859_1_descriptors [] = {
+FONT_DATA font_char_desc_t _fonts_terminus_8x14_iso8859_1_descriptors [] = {
 { 0x08, 0x0000 }, /* Index: 0x00, char: \x01 */
 { 0x08, 0x000e }, /* Index: 0x01, char: \x02 */
 { 0x08, 0x001c }, /* Index: 0x02, char: \x03 */
@@ -4356,7 +4356,7 @@ const font_char_desc_t _fonts_terminus_8x14_iso8859_1_descriptors [] = {
 { 0x08, 0x0de4 }, /* Index: 0xfe, char: \xff */
 };
 
-const font_info_t _fonts_terminus_8x14_iso8859_1_info = {    //
+FONT_DATA font_info_t _fonts_terminus_8x14_iso8859_1_info = {    //
         .name = "terminus_8x14_iso8859_1",    //
                 .height = 14, /* Character height */
                 .c = 0, /* C */
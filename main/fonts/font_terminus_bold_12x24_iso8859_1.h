@@ -15,7 +15,7 @@
 #ifndef _EXTRAS_FONTS_FONT_TERMINUS_BOLD_12X24_ISO8859_1_H_
 #define _EXTRAS_FONTS_FONT_TERMINUS_BOLD_12X24_ISO8859_1_H_
 
-static const uint8_t _fonts_terminus_bold_12x24_iso8859_1_bitmaps [] = {
+static FONT_DATA uint8_t _fonts_terminus_bold_12x24_iso8859_1_bitmaps [] = {
 
 /* Index: 0x00, char: \x01, offset: 0x0000 */
 0x00, 0x00, /* ................ */
@@ -6648,7 +6648,7 @@ static const uint8_t _fonts_terminus_bold_12x24_iso8859_1_bitmaps [] = {
 0x00, 0x00, /* ................ */
 };
 
-const font_char_desc_t _fonts_terminus_bold_12x24_iso8859_1_descriptors [] = {
+FONT_DATA font_char_desc_t _fonts_terminus_bold_12x24_iso8859_1_descriptors [] = {
 { 0x0c, 0x0000 }, /* Index: 0x00, char: \x01 */
 { 0x0c, 0x0030 }, /* Index: 0x01, char: \x02 */
 { 0x0c, 0x0060 }, /* Index: 0x02, char: \x03 */
@@ -6906,7 +6906,7 @@ const font_char_desc_t _fonts_terminus_bold_12x24_iso8859_1_descriptors [] = {
 { 0x0c, 0x2fa0 }, /* Index: 0xfe, char: \xff */
 };
 
-const font_info_t _fonts_terminus_bold_12x24_iso8859_1_info = {    //
+FONT_DATA font_info_t _fonts_terminus_bold_12x24_iso8859_1_info = {    //
         .name = "terminus_bold_12x24_iso8859_1",    //
                 .height = 24, /* Character height */
                 .c = 0, /* C */
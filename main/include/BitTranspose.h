@@ -0,0 +1,77 @@
+/*
+ Raster-Font Library Bit Transpose
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_BITTRANSPOSE_H_
+#define INCLUDE_BITTRANSPOSE_H_
+
+#include <stdint.h>
+
+/**
+ * @brief L-R/T-B to T-B/L-R transpose kernels
+ *
+ * Characters are transposed in 8x8 bit blocks, eight rows of one font byte
+ * becoming eight page column bytes.
+ */
+enum TransposeKernel
+{
+    TRANSPOSE_SCALAR, ///< Bit at a time reference
+    TRANSPOSE_SWAR,   ///< Portable 64 bit word 8x8 transpose
+    TRANSPOSE_SSE2,   ///< x86 SSE2 byte mask extraction, two pages per step
+    TRANSPOSE_AVX2,   ///< x86 AVX2 byte mask extraction, four pages per step
+    TRANSPOSE_NEON,   ///< ARM NEON (AArch64) lane shift and add, two pages per step
+    TRANSPOSE_KERNELS
+};
+
+/**
+ * @brief The page layouts characters are transposed into
+ */
+enum PageOrder
+{
+    PAGE_LSB_TOP,   ///< Pages top to bottom, the top row of each in the LSB
+    PAGE_MSB_TOP,   ///< Pages top to bottom, the top row of each in the MSB
+    PAGE_BOTTOM_UP, ///< Pages bottom to top, the bottom row of each in the LSB
+};
+
+extern const uint8_t *const BIT_REVERSE; ///< Each byte with its bits reversed
+
+void TransposeChar(const uint8_t *char_bitmap, uint8_t width, uint8_t height, uint8_t phase, uint8_t *pages, uint16_t stride,
+                   PageOrder order = PAGE_LSB_TOP);
+
+TransposeKernel ActiveTransposeKernel();
+bool SelectTransposeKernel(TransposeKernel kernel);
+bool TransposeKernelSupported(TransposeKernel kernel);
+const char *TransposeKernelName(TransposeKernel kernel);
+
+#define MAX_SCALE 8 ///< Largest integer scale factor
+
+void ScaleRows(const uint8_t *rows, uint8_t width, uint8_t height, uint8_t scale, uint8_t *scaled);
+void TransposeScaledChar(const uint8_t *char_bitmap, uint8_t width, uint8_t height, uint8_t x_scale, uint8_t y_scale, uint8_t phase,
+                         uint8_t *pages, uint16_t stride, PageOrder order = PAGE_LSB_TOP);
+void RotateChar(const uint8_t *char_bitmap, uint8_t width, uint8_t height, uint8_t turns, uint8_t *rotated);
+
+#define MAX_PIXEL_BYTES 3 ///< Bytes of the widest color pixel
+
+void ExpandPixels(const uint8_t *rows, uint16_t row_bytes, uint16_t width, uint8_t height, uint8_t y_scale, uint8_t pixel_bytes,
+                  const uint8_t *foreground, const uint8_t *background, uint8_t *pixels, uint16_t stride);
+
+#define MAX_DOWNSAMPLE 4 ///< Largest box filter factor
+
+void ShrinkRows(const uint8_t *rows, uint16_t row_bytes, uint8_t width, uint8_t height, uint8_t factor, uint8_t bits, uint8_t phase,
+                uint8_t *gray, uint16_t gray_bytes);
+
+#endif /* INCLUDE_BITTRANSPOSE_H_ */
@@ -0,0 +1,107 @@
+/*
+ Raster-Font Library Bitmap Arena
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_BITMAPARENA_H_
+#define INCLUDE_BITMAPARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory_resource>
+
+/**
+ * @brief Allocation statistics for the bitmap memory resources
+ */
+struct ArenaStats
+{
+    size_t capacity{0};       ///< Bytes (arena) or blocks (pool) available
+    size_t used{0};           ///< Bytes or blocks currently allocated
+    size_t high_water{0};     ///< Most bytes or blocks allocated at once
+    uint32_t allocations{0};  ///< Allocations served
+    uint32_t resets{0};       ///< Times the arena was reset
+    uint32_t overflows{0};    ///< Allocations that did not fit and fell back to the upstream resource
+};
+
+/**
+ * @brief Frame scoped bump allocator for bitmaps
+ *
+ * Allocation is a pointer bump within a fixed buffer, and the whole frame is
+ * released at once with Reset. Deallocation only reclaims the most recent
+ * allocation. Requests that do not fit are passed to the upstream resource.
+ * Bitmaps allocated from the arena must be destroyed before it is reset.
+ * Not thread safe.
+ */
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+    FrameArena(void *buffer, size_t bytes, std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+    explicit FrameArena(size_t bytes, std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+    ~FrameArena();
+
+    void Reset();
+    const ArenaStats &Stats() const;
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+private:
+    uint8_t *m_buffer;                     ///< The arena memory
+    size_t m_top{0};                       ///< Offset of the next free byte
+    bool m_owned;                          ///< The buffer was allocated from upstream
+    std::pmr::memory_resource *m_upstream; ///< Resource for the buffer and overflows
+    ArenaStats m_stats;                    ///< Statistics, capacity and use in bytes
+};
+
+/**
+ * @brief Fixed block pool allocator for bitmaps
+ *
+ * Blocks of one size are handed out from a free list, suiting single character
+ * bitmaps sized with FontManager::MaxCharBytes. Requests larger than a block, or
+ * made when the pool is exhausted, are passed to the upstream resource.
+ * Not thread safe.
+ */
+class BlockPool : public std::pmr::memory_resource
+{
+public:
+    BlockPool(size_t blockBytes, size_t blocks, std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+    BlockPool(const BlockPool &) = delete;
+    BlockPool &operator=(const BlockPool &) = delete;
+    ~BlockPool();
+
+    size_t BlockBytes() const;
+    const ArenaStats &Stats() const;
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+private:
+    uint8_t *m_buffer;                     ///< The pool memory
+    size_t m_block_bytes;                  ///< Size of each block, rounded for pointer alignment
+    void *m_free{nullptr};                 ///< Head of the free block list
+    std::pmr::memory_resource *m_upstream; ///< Resource for the pool and overflows
+    ArenaStats m_stats;                    ///< Statistics, capacity and use in blocks
+
+    bool Owns(const void *p) const;
+};
+
+#endif /* INCLUDE_BITMAPARENA_H_ */
@@ -0,0 +1,54 @@
+/*
+ Raster-Font Library Code Page
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_CODEPAGE_H_
+#define INCLUDE_CODEPAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define UTF8_REPLACEMENT 0xFFFD ///< Code point decoded from malformed UTF-8
+
+/**
+ * @brief The byte encodings of the fonts
+ *
+ * Bytes below 0x80 are ASCII in every code page.
+ */
+enum CodePage
+{
+    CODEPAGE_ASCII,     ///< ASCII only, bytes from 0x80 unmapped
+    CODEPAGE_ISO8859_1, ///< Latin-1, each byte its code point
+    CODEPAGE_KOI8_R,    ///< Russian KOI8-R
+    CODEPAGES
+};
+
+CodePage CodePageOf(const char *font_name);
+const char *CodePageName(CodePage page);
+uint32_t CodePageChar(CodePage page, unsigned char c);
+int CodePageByte(CodePage page, uint32_t code);
+
+size_t AsciiSpan(const char *text, size_t length);
+uint32_t DecodeUtf8(std::string_view str, size_t &pos);
+void EncodeUtf8(uint32_t code, std::string &out);
+std::string_view TranscodeUtf8(std::string_view str, CodePage page, unsigned char first, unsigned char last,
+                               unsigned char fallback, std::string &bytes, std::vector<size_t> *starts = nullptr);
+
+#endif /* INCLUDE_CODEPAGE_H_ */
@@ -0,0 +1,48 @@
+/*
+ Raster-Font Library Compressed Fonts
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_COMPRESSEDFONTS_H_
+#define INCLUDE_COMPRESSEDFONTS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fonts.h"
+
+/**
+ * @brief Font characters bit-packed at compile time
+ *
+ * Each glyph is a header of the blank rows above the glyph and the rows stored,
+ * a nibble each in one byte for fonts under 16 rows high, else a byte each, then
+ * the stored rows of width bits each, MSB first, one after the other without the
+ * padding to a byte at the end of each row. The last byte of a glyph is zero
+ * padded and rows below those stored are blank.
+ */
+typedef struct _compressed_font_info
+{
+    const uint8_t *glyphs;    ///< Packed glyph data
+    const uint16_t *offsets;  ///< Offset of each glyph in glyphs, indexed as the font char_descriptors
+    uint32_t size;            ///< Bytes of glyph data
+} compressed_font_info_t;
+
+extern const compressed_font_info_t *compressed_fonts[NUM_FONTS]; ///< Compressed glyphs of fonts[], nullptr where not baked
+
+size_t CompressFont(const font_info_t *font, uint8_t *glyphs, uint16_t *offsets);
+void DecodeGlyph(const compressed_font_info_t *compressed, const font_info_t *font, unsigned char index, uint8_t *rows);
+
+#endif /* INCLUDE_COMPRESSEDFONTS_H_ */
@@ -23,9 +23,20 @@
 //#include <stdlib.h>
 #include <vector>
 #include <cstring>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
+#include "CodePage.h"
+#include "CompressedFonts.h"
 #include "fonts.h"
+#include "PagedFonts.h"
+
+#ifndef RASTERFONT_GLYPH_CACHE
+#define RASTERFONT_GLYPH_CACHE 1 ///< Set to 0 to compile out the PTBLR and gray glyph cache on RAM constrained builds
+#endif
+
+struct FontEngine;
 
 /**
  * @brief 
@@ -41,14 +52,23 @@ public:
      */
     enum Raster
     {
-        LRTB,  ///< Cartesian Left->Right, Top->Bottom
-        PTBLR, ///< Paged Top->Bottom, Left->Right
+        LRTB,      ///< Cartesian Left->Right, Top->Bottom
+        PTBLR,     ///< Paged Top->Bottom, Left->Right
+        LRTB_LSB,  ///< Cartesian Left->Right, Top->Bottom, the left pixel of each byte in the LSB
+        PTBLR_MSB, ///< Paged Top->Bottom, Left->Right, the top pixel of each byte in the MSB
+        PBTLR,     ///< Paged Bottom->Top, Left->Right, the bottom pixel of each byte in the LSB
+        RGB565,    ///< Color Left->Right, Top->Bottom, 2 byte pixels, the high byte first
+        RGB888,    ///< Color Left->Right, Top->Bottom, 3 byte pixels, red, green then blue
+        INDEXED8,  ///< Color Left->Right, Top->Bottom, 1 byte palette index pixels
+        GRAY2,     ///< Gray Left->Right, Top->Bottom, 2 bit pixels, the leftmost in the high bits
+        GRAY4,     ///< Gray Left->Right, Top->Bottom, 4 bit pixels, the left in the high nibble (SSD1322)
     };
 
     /**
      * @brief Orientation
      * 
-     *  The orientation of output characters 
+     *  The orientation of output characters, the way their tops face,
+     *  each a quarter turn clockwise from the last
      */
     enum Orientation
     {
@@ -69,13 +89,15 @@ public:
     };
 
     /**
-     * @brief Rasterized text and configuration info
+     * @brief Rasterized text and configuration info over a caller owned buffer
      * 
-     * Container for rasterized text, information on 
-     * how it was rasterized and how to map the data to the display.
-     * Data is contained within a byte array of size bytes_per_row*bytes_per_column
+     * Information on how the text was rasterized and how to map the data to the display.
+     * Rows (LRTB) or pages (PTBLR) of bytes_per_row bytes start every stride bytes,
+     * bytes_per_column of them. The caller sets data, size, stride and clear.
+     * Color rows hold whole pixels, and are cleared to the background color.
+     * Gray rows pack 2 or 4 bit pixels, offset by whole pixels.
      */
-    struct Bitmap
+    struct BitmapView
     {
         Raster raster;                   ///< Rasterization
         Orientation orientation;         ///< Text orientation
@@ -85,38 +107,182 @@ public:
         uint8_t height_offset_pixels{0}; ///< bits the raster data is offset from the top
         uint16_t bytes_per_row{0};       ///< Byte row width to contain data and position offset
         uint16_t bytes_per_column{0};    ///< Byte column height to contain data and position offset
-        uint16_t bitpoint{0};           ///< Current bit-point to place scan data
+        uint16_t bitpoint{0};            ///< Current bit-point to place scan data, along the text
+        uint16_t stride{0};              ///< Bytes from the start of one row or page to the next, 0 for bytes_per_row
+        bool clear{true};                ///< Zero the rasterized area first, false to OR into existing data
+        size_t size{0};                  ///< Bytes available at data
         uint8_t *data{nullptr};          ///< The rasterized string data
+    };
+
+    /**
+     * @brief Rasterized text and configuration info
+     * 
+     * Container for rasterized text, information on 
+     * how it was rasterized and how to map the data to the display.
+     * Data is contained within a byte array of size bytes_per_row*bytes_per_column,
+     * owned by the bitmap and allocated from its memory resource.
+     * Bitmaps move but do not copy.
+     */
+    struct Bitmap : BitmapView
+    {
+        std::pmr::memory_resource *resource; ///< The memory resource data is allocated from
 
-        ~Bitmap()
+        explicit Bitmap(std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+        Bitmap(Bitmap &&other) noexcept;
+        Bitmap &operator=(Bitmap &&other) noexcept;
+        Bitmap(const Bitmap &) = delete;
+        Bitmap &operator=(const Bitmap &) = delete;
+        ~Bitmap();
+
+        void Allocate(size_t bytes);
+        void Release();
+    };
+
+    /**
+     * @brief A string to rasterize in a batch and its position offset
+     */
+    struct BatchItem
+    {
+        std::string_view str;   ///< String to bitmap
+        uint16_t bitOffset{0};  ///< The number of bits to shift the bitmap
+    };
+
+    /**
+     * @brief Throughput counters of the last batch rasterized
+     */
+    struct BatchStats
+    {
+        uint32_t items{0};         ///< Strings rasterized
+        uint32_t glyphs{0};        ///< Characters rasterized
+        size_t bytes{0};           ///< Bitmap bytes produced
+        uint32_t measure_us{0};    ///< Microseconds measuring and laying out
+        uint32_t rasterize_us{0};  ///< Microseconds allocating and rasterizing
+    };
+
+    /**
+     * @brief The bitmaps of a batch of strings, held in one contiguous block
+     *
+     * The index holds the bitmap of each item in order, their data pointing into
+     * the block. Rasterizing again into the same batch reuses its storage.
+     */
+    struct BitmapBatch
+    {
+        std::pmr::vector<BitmapView> index;       ///< The bitmap of each item
+        std::pmr::vector<uint8_t> block;          ///< The data of all the bitmaps, back to back
+        std::pmr::string text;                    ///< The font bytes of the items mapped from UTF-8, back to back
+        std::pmr::vector<std::string_view> texts; ///< The font bytes of each item, in text or the item itself
+        BatchStats stats;                         ///< Counters for the last batch
+
+        explicit BitmapBatch(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : index{resource}, block{resource}, text{resource}, texts{resource}
         {
-            printf("Delete\n");
-            delete[] data;
         }
     };
 
     static uint8_t FontCount();
     static const char **FontList();
+    static bool PrepareView(BitmapView &view, Raster raster, XY xy, uint16_t bitOffset, Orientation orientation = T);
+    static bool PagedRaster(Raster raster);
+    static uint8_t PixelBytes(Raster raster);
+    static uint8_t GrayBits(Raster raster);
 
     FontManager(uint8_t fontIndex, Raster raster, Orientation orientation = T);
+    FontManager(const font_info_t &font, Raster raster, Orientation orientation = T);
+    FontManager(const wide_font_info_t &font, Raster raster, Orientation orientation = T);
+    FontManager(const subset_font_info_t &font, Raster raster, Orientation orientation = T);
     virtual ~FontManager()
     {
     }
 
+#if RASTERFONT_GLYPH_CACHE
+    void GlyphCache(bool enable);
+    size_t GlyphCacheBytes();
+#endif
+
     const char *FontName();
     uint8_t FontHeight();
     uint8_t FontC();
-    XY MeasureString(std::string str);
-    std::vector<uint16_t> CharacterBreaks(std::string str, uint16_t pixels);
-    Bitmap Rasterize(std::string str, uint16_t bitOffset = 0);
-    Bitmap Rasterize(unsigned char c, uint16_t bitOffset = 0);
+    bool Scale(uint8_t x_scale, uint8_t y_scale);
+    bool Downsample(uint8_t factor);
+    Raster FontRaster();
+    Orientation FontOrientation();
+    void Colors(uint32_t foreground, uint32_t background, bool transparent = false);
+    void ClearView(BitmapView &view);
+    CodePage FontCodePage();
+    void FontCodePage(CodePage page);
+    void Utf8(bool enable);
+    bool Utf8();
+    void Fallback(unsigned char c);
+    std::string_view FontText(std::string_view str, std::string &bytes, std::vector<size_t> *starts = nullptr);
+    uint8_t CharWidth(unsigned char c);
+    XY MeasureString(std::string_view str);
+    std::vector<uint16_t> CharacterBreaks(std::string_view str, uint16_t pixels);
+    size_t RequiredBytes(std::string_view str, uint16_t bitOffset = 0, uint16_t stride = 0);
+    size_t RequiredBytes(unsigned char c, uint16_t bitOffset = 0, uint16_t stride = 0);
+    size_t MaxCharBytes();
+    bool RasterizeInto(std::string_view str, BitmapView &view, uint16_t bitOffset = 0);
+    bool RasterizeInto(unsigned char c, BitmapView &view, uint16_t bitOffset = 0);
+    Bitmap Rasterize(std::string_view str, uint16_t bitOffset = 0,
+                     std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    Bitmap Rasterize(unsigned char c, uint16_t bitOffset = 0,
+                     std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    BitmapBatch RasterizeBatch(const BatchItem *items, size_t count,
+                               std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    void RasterizeBatch(const BatchItem *items, size_t count, BitmapBatch &batch);
 
 private:
     const font_info_t *m_font;       ///< The font managed by this object
+    const paged_font_info_t *m_paged; ///< The compile time paged raster of the font, if baked
+    const compressed_font_info_t *m_compressed; ///< The compile time compressed glyphs of the font, if baked
+    std::vector<uint8_t> m_glyph_rows;          ///< The rows of the last glyph decompressed
     const Raster m_raster;           ///< Raster direction
     const Orientation m_orientation; ///< Character orientation
+    const FontEngine *m_engine;      ///< The font and raster specialized string entry points, nullptr for fonts not compiled in
+    CodePage m_codepage;             ///< Byte encoding of the font
+    bool m_utf8{false};              ///< Strings are UTF-8, mapped to the code page
+    unsigned char m_fallback;        ///< Byte for code points the font cannot show
+    unsigned char m_first;           ///< First character code strings may hold, before any subset remap
+    unsigned char m_last;            ///< Last character code strings may hold, before any subset remap
+    std::string m_text;              ///< The font bytes of the last string mapped from UTF-8
+    const wide_font_info_t *m_wide{nullptr}; ///< The wide font, whose info is m_font, if by code point
+    uint32_t m_wide_fallback{0};             ///< Character index shown for code points the wide font lacks
+    const subset_font_info_t *m_subset{nullptr}; ///< The subset font, whose info is m_font, if remapping codes
+    uint8_t m_subset_replacement{0};             ///< Character index shown for codes dropped from the subset
+    uint8_t m_scale_x{1};                        ///< Times each column is repeated
+    uint8_t m_scale_y{1};                        ///< Times each row is repeated
+    bool m_scaled{false};                        ///< Either scale is above 1
+    uint8_t m_shrink{1};                         ///< Gray rasters' box filter factor, font pixels across and down each gray pixel
+    std::vector<uint8_t> m_gray_rows;            ///< The gray rows of the last character filtered, when not cached
+    std::vector<uint8_t> m_scaled_rows;          ///< The rows of the last character spread by the x scale
+    std::vector<uint8_t> m_rotated_rows;         ///< The rows of the last character turned to the orientation
+    uint8_t m_foreground[8 * 3]{};               ///< Color rasters' foreground pixel, repeated for 8 pixels
+    uint8_t m_background[8 * 3]{};               ///< Color rasters' background pixel, repeated for 8 pixels
+    bool m_transparent{false};                   ///< Color rasters leave background pixels as they are
+
+    FontManager(const font_info_t *font, Raster raster, Orientation orientation,
+                const paged_font_info_t *paged, const compressed_font_info_t *compressed, const FontEngine *engine);
+
+    uint32_t CharIndex(uint32_t c);
+    bool WideIndex(uint32_t code, uint32_t &index);
+    uint32_t CharCount();
+    wide_char_desc_t Descriptor(uint32_t c);
+    uint8_t Width(uint32_t c);
+    const uint8_t *CharBitmap(uint32_t c);
+    const uint8_t *OrientedBitmap(uint32_t c);
+    template <typename Visit>
+    void ForEachChar(std::string_view text, Visit visit);
+    XY MeasureText(std::string_view text);
+    XY MeasureChar(uint32_t c);
+    void RasterString(std::string_view str, BitmapView &view);
+    void RasterChar(uint32_t c, BitmapView &scan);
+    void ShrinkChar(uint32_t c, uint8_t phase, uint8_t *gray);
+
+#if RASTERFONT_GLYPH_CACHE
+    bool m_glyph_cache_enabled{true};                 ///< PTBLR and gray rasterization reads from the glyph cache
+    std::vector<std::vector<uint8_t>> m_glyph_cache; ///< Per character PTBLR columns for all 8 phases, or gray rows for every pixel phase, empty until first use
 
-    void RasterChar(unsigned char c, Bitmap &scan);
+    const uint8_t *CachedGlyph(uint32_t c);
+#endif
 };
 
 #endif /* INCLUDE_FONTMANAGER_H_ */
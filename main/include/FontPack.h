@@ -0,0 +1,111 @@
+/*
+ Raster-Font Library Font Pack
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_FONTPACK_H_
+#define INCLUDE_FONTPACK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "fonts.h"
+
+#define FONT_PACK_VERSION 2  ///< Version of the pack layout written, version 1 packs having no subset fonts
+#define FONT_PACK_ALIGN 8    ///< Alignment of each section from the start of the pack
+
+/**
+ * @brief The header at the start of a font pack
+ *
+ * Packs are little-endian, offsets are from the start of the pack and each
+ * section starts on a FONT_PACK_ALIGN boundary.
+ */
+typedef struct _font_pack_header
+{
+    char magic[4];             ///< "RFPK"
+    uint16_t version;          ///< FONT_PACK_VERSION
+    uint16_t font_count;       ///< Entries in the directory
+    uint32_t pack_bytes;       ///< Size of the pack
+    uint32_t directory_offset; ///< The font directory
+    uint32_t reserved[4];      ///< Zero
+} font_pack_header_t;
+
+/**
+ * @brief A font directory entry
+ *
+ * The descriptors are char_end - char_start + 1 of 4 bytes each: the width, a
+ * zero byte and the 16 bit bitmap offset, the layout of font_char_desc_t, so
+ * the descriptors and bitmap are used in place. The remap table of a subset
+ * font is the first and last code of the original font, then the kept character
+ * of each code between them, as subset_font_info_t.
+ */
+typedef struct _font_pack_entry
+{
+    uint32_t name_offset;        ///< Null terminated font name
+    uint32_t descriptors_offset; ///< Character descriptor table
+    uint32_t bitmap_offset;      ///< Character bitmaps, L-R/T-B as the font headers
+    uint32_t bitmap_bytes;       ///< Size of the bitmaps
+    uint8_t height;              ///< Character height in pixels
+    uint8_t c;                   ///< "C" spacing between adjacent characters
+    uint8_t char_start;          ///< First character
+    uint8_t char_end;            ///< Last character
+    uint32_t remap_offset;       ///< Remap table of a subset font, zero for whole fonts
+} font_pack_entry_t;
+
+/**
+ * @brief Fonts loaded at run time from a binary font pack, used in place
+ *
+ * The pack is memory mapped, or attached where it already is in memory, such as
+ * a mapped flash partition, and each font's descriptors and bitmaps are used
+ * where they lie through a font_info_t for a FontManager. Opening checks only the
+ * header and each font only its directory entry, so the cost does not grow with
+ * the size of the pack; Verify checks every character. Subset fonts are taken
+ * through Subset or FindSubset, with the remap of their character codes.
+ */
+class FontPack
+{
+public:
+    FontPack();
+    ~FontPack();
+    FontPack(const FontPack &) = delete;
+    FontPack &operator=(const FontPack &) = delete;
+
+    static bool Write(const char *path, const font_info_t *const *fonts, size_t count);
+    static bool Write(const char *path, const subset_font_info_t *const *fonts, size_t count);
+    static std::vector<uint8_t> Build(const font_info_t *const *fonts, size_t count);
+    static std::vector<uint8_t> Build(const subset_font_info_t *const *fonts, size_t count);
+    static size_t BitmapBytes(const font_info_t *font);
+
+    bool Open(const char *path);
+    bool Attach(const void *data, size_t size);
+    void Close();
+    uint16_t FontCount() const;
+    const font_info_t *Font(uint16_t index);
+    const font_info_t *Find(const char *name);
+    const subset_font_info_t *Subset(uint16_t index);
+    const subset_font_info_t *FindSubset(const char *name);
+    bool Verify();
+
+private:
+    const uint8_t *m_data{nullptr};  ///< The pack
+    size_t m_size{0};                ///< Bytes of the pack
+    void *m_map{nullptr};            ///< The mapping of an opened pack, to unmap
+    size_t m_map_bytes{0};           ///< Bytes mapped
+    std::vector<subset_font_info_t> m_fonts; ///< The font of each directory entry, name null until first used
+};
+
+#endif /* INCLUDE_FONTPACK_H_ */
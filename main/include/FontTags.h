@@ -0,0 +1,106 @@
+/*
+ Raster-Font Library Font Tags
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_FONTTAGS_H_
+#define INCLUDE_FONTTAGS_H_
+
+#include <stdint.h>
+
+#include "fonts.h"
+
+/*
+ * The font tables, defined by fonts.c
+ */
+extern "C" {
+extern const font_info_t _fonts_glcd_5x7_info;
+extern const font_info_t _fonts_bitocra_4x7_ascii_info;
+extern const font_info_t _fonts_roboto_8pt_ascii_info;
+extern const font_info_t _fonts_roboto_10pt_ascii_info;
+extern const font_info_t _font_tahoma_8pt_ascii_info;
+extern const font_info_t _fonts_bitocra_6x11_iso8859_1_info;
+extern const font_info_t _fonts_bitocra_7x13_iso8859_1_info;
+extern const font_info_t _fonts_terminus_6x12_iso8859_1_info;
+extern const font_info_t _fonts_terminus_8x14_iso8859_1_info;
+extern const font_info_t _fonts_terminus_10x18_iso8859_1_info;
+extern const font_info_t _fonts_terminus_11x22_iso8859_1_info;
+extern const font_info_t _fonts_terminus_12x24_iso8859_1_info;
+extern const font_info_t _fonts_terminus_14x28_iso8859_1_info;
+extern const font_info_t _fonts_terminus_16x32_iso8859_1_info;
+extern const font_info_t _fonts_terminus_bold_8x14_iso8859_1_info;
+extern const font_info_t _fonts_terminus_bold_10x18_iso8859_1_info;
+extern const font_info_t _fonts_terminus_bold_11x22_iso8859_1_info;
+extern const font_info_t _fonts_terminus_bold_12x24_iso8859_1_info;
+extern const font_info_t _fonts_terminus_bold_14x28_iso8859_1_info;
+extern const font_info_t _fonts_terminus_bold_16x32_iso8859_1_info;
+extern const font_info_t _fonts_terminus_6x12_koi8_r_info;
+extern const font_info_t _fonts_terminus_8x14_koi8_r_info;
+extern const font_info_t _fonts_terminus_14x28_koi8_r_info;
+extern const font_info_t _fonts_terminus_16x32_koi8_r_info;
+extern const font_info_t _fonts_terminus_bold_8x14_koi8_r_info;
+extern const font_info_t _fonts_terminus_bold_14x28_koi8_r_info;
+extern const font_info_t _fonts_terminus_bold_16x32_koi8_r_info;
+}
+
+/**
+ * @brief Compile time metrics of a font, naming it as a template parameter
+ *
+ * The metrics are checked against the font headers when the library is compiled.
+ */
+template <const font_info_t &Info, uint8_t Height, uint8_t C, unsigned char CharStart, unsigned char CharEnd, uint8_t MaxWidth>
+struct FontTag
+{
+    static constexpr const font_info_t &info = Info;       ///< The font tables
+    static constexpr uint8_t height = Height;              ///< Character height in pixels
+    static constexpr uint8_t c = C;                        ///< Space between adjacent characters
+    static constexpr unsigned char char_start = CharStart; ///< First character
+    static constexpr unsigned char char_end = CharEnd;     ///< Last character
+    static constexpr uint8_t max_width = MaxWidth;         ///< Widest character in pixels
+};
+
+namespace FontTags
+{
+struct glcd_5x7 : FontTag<_fonts_glcd_5x7_info, 7, 1, 1, 255, 5> {};
+struct bitocra_4x7_ascii : FontTag<_fonts_bitocra_4x7_ascii_info, 7, 0, 32, 127, 4> {};
+struct roboto_8pt_ascii : FontTag<_fonts_roboto_8pt_ascii_info, 11, 2, 33, 126, 9> {};
+struct roboto_10pt_ascii : FontTag<_fonts_roboto_10pt_ascii_info, 14, 2, 33, 126, 11> {};
+struct tahoma_8pt_ascii : FontTag<_font_tahoma_8pt_ascii_info, 11, 1, 33, 126, 10> {};
+struct bitocra_6x11_iso8859_1 : FontTag<_fonts_bitocra_6x11_iso8859_1_info, 11, 0, 32, 255, 6> {};
+struct bitocra_7x13_iso8859_1 : FontTag<_fonts_bitocra_7x13_iso8859_1_info, 13, 0, 32, 255, 7> {};
+struct terminus_6x12_iso8859_1 : FontTag<_fonts_terminus_6x12_iso8859_1_info, 12, 0, 1, 255, 6> {};
+struct terminus_8x14_iso8859_1 : FontTag<_fonts_terminus_8x14_iso8859_1_info, 14, 0, 1, 255, 8> {};
+struct terminus_10x18_iso8859_1 : FontTag<_fonts_terminus_10x18_iso8859_1_info, 18, 0, 1, 255, 10> {};
+struct terminus_11x22_iso8859_1 : FontTag<_fonts_terminus_11x22_iso8859_1_info, 22, 0, 1, 255, 11> {};
+struct terminus_12x24_iso8859_1 : FontTag<_fonts_terminus_12x24_iso8859_1_info, 24, 0, 1, 255, 12> {};
+struct terminus_14x28_iso8859_1 : FontTag<_fonts_terminus_14x28_iso8859_1_info, 28, 0, 1, 255, 14> {};
+struct terminus_16x32_iso8859_1 : FontTag<_fonts_terminus_16x32_iso8859_1_info, 32, 0, 1, 255, 16> {};
+struct terminus_bold_8x14_iso8859_1 : FontTag<_fonts_terminus_bold_8x14_iso8859_1_info, 14, 0, 1, 255, 8> {};
+struct terminus_bold_10x18_iso8859_1 : FontTag<_fonts_terminus_bold_10x18_iso8859_1_info, 18, 0, 1, 255, 10> {};
+struct terminus_bold_11x22_iso8859_1 : FontTag<_fonts_terminus_bold_11x22_iso8859_1_info, 22, 0, 1, 255, 11> {};
+struct terminus_bold_12x24_iso8859_1 : FontTag<_fonts_terminus_bold_12x24_iso8859_1_info, 24, 0, 1, 255, 12> {};
+struct terminus_bold_14x28_iso8859_1 : FontTag<_fonts_terminus_bold_14x28_iso8859_1_info, 28, 0, 1, 255, 14> {};
+struct terminus_bold_16x32_iso8859_1 : FontTag<_fonts_terminus_bold_16x32_iso8859_1_info, 32, 0, 1, 255, 16> {};
+struct terminus_6x12_koi8_r : FontTag<_fonts_terminus_6x12_koi8_r_info, 12, 0, 1, 255, 6> {};
+struct terminus_8x14_koi8_r : FontTag<_fonts_terminus_8x14_koi8_r_info, 14, 0, 1, 255, 8> {};
+struct terminus_14x28_koi8_r : FontTag<_fonts_terminus_14x28_koi8_r_info, 28, 0, 1, 255, 14> {};
+struct terminus_16x32_koi8_r : FontTag<_fonts_terminus_16x32_koi8_r_info, 32, 0, 1, 255, 16> {};
+struct terminus_bold_8x14_koi8_r : FontTag<_fonts_terminus_bold_8x14_koi8_r_info, 14, 0, 1, 255, 8> {};
+struct terminus_bold_14x28_koi8_r : FontTag<_fonts_terminus_bold_14x28_koi8_r_info, 28, 0, 1, 255, 14> {};
+struct terminus_bold_16x32_koi8_r : FontTag<_fonts_terminus_bold_16x32_koi8_r_info, 32, 0, 1, 255, 16> {};
+} // namespace FontTags
+
+#endif /* INCLUDE_FONTTAGS_H_ */
@@ -0,0 +1,140 @@
+/*
+ Raster-Font Library Instrumentation
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_INSTRUMENT_H_
+#define INCLUDE_INSTRUMENT_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+
+#ifndef RASTERFONT_INSTRUMENT
+#define RASTERFONT_INSTRUMENT 0 ///< Set to 1 to compile in the hot path counters and latency timers
+#endif
+
+#define LATENCY_BUCKETS 32 ///< Power of two nanosecond latency buckets, the last open ended
+
+/**
+ * @brief Counted events
+ */
+enum InstrumentCounter
+{
+    COUNT_GLYPHS,          ///< Characters rasterized
+    COUNT_BITMAPS,         ///< Bitmaps allocated
+    COUNT_BYTES_ALLOCATED, ///< Bitmap and batch bytes allocated
+    COUNT_CACHE_HITS,      ///< PTBLR and gray glyph cache hits
+    COUNT_CACHE_MISSES,    ///< PTBLR and gray glyph cache misses, each filling the cache
+    COUNT_PAGED_GLYPHS,    ///< PTBLR characters copied from a compile time paged font
+    INSTRUMENT_COUNTERS
+};
+
+/**
+ * @brief Timed calls
+ */
+enum InstrumentTimer
+{
+    TIME_RASTERIZE_CHAR,    ///< Rasterize a character
+    TIME_RASTERIZE_STRING,  ///< Rasterize a string
+    TIME_RASTERIZE_INTO,    ///< RasterizeInto a caller owned buffer
+    TIME_RASTERIZE_BATCH,   ///< RasterizeBatch
+    TIME_MEASURE_STRING,    ///< Measuring text, by MeasureString and by the rasterize calls
+    TIME_CHARACTER_BREAKS,  ///< CharacterBreaks
+    INSTRUMENT_TIMERS
+};
+
+/**
+ * @brief Receives the instrumentation events
+ *
+ * Events arrive from whichever thread is rasterizing, so sinks must be thread safe.
+ */
+class InstrumentSink
+{
+public:
+    virtual ~InstrumentSink() = default;
+    virtual void Count(InstrumentCounter counter, uint64_t n) = 0;
+    virtual void Latency(InstrumentTimer timer, uint64_t ns) = 0;
+};
+
+/**
+ * @brief The aggregated events at a point in time
+ */
+struct InstrumentSnapshot
+{
+    uint64_t counters[INSTRUMENT_COUNTERS]{};                 ///< Counter totals
+    uint64_t calls[INSTRUMENT_TIMERS]{};                      ///< Timed calls
+    uint64_t total_ns[INSTRUMENT_TIMERS]{};                   ///< Time in the timed calls
+    uint64_t max_ns[INSTRUMENT_TIMERS]{};                     ///< Slowest call
+    uint64_t histogram[INSTRUMENT_TIMERS][LATENCY_BUCKETS]{}; ///< Calls by latency, bucket b from 2^b ns
+
+    uint64_t Percentile(InstrumentTimer timer, double percent) const;
+};
+
+/**
+ * @brief Sink aggregating counters and latency histograms, the default sink
+ */
+class StatsSink : public InstrumentSink
+{
+public:
+    void Count(InstrumentCounter counter, uint64_t n) override;
+    void Latency(InstrumentTimer timer, uint64_t ns) override;
+
+    InstrumentSnapshot Snapshot() const;
+    void Reset();
+    void Report(FILE *out) const;
+
+private:
+    std::atomic<uint64_t> m_counters[INSTRUMENT_COUNTERS]{};
+    std::atomic<uint64_t> m_calls[INSTRUMENT_TIMERS]{};
+    std::atomic<uint64_t> m_total_ns[INSTRUMENT_TIMERS]{};
+    std::atomic<uint64_t> m_max_ns[INSTRUMENT_TIMERS]{};
+    std::atomic<uint64_t> m_histogram[INSTRUMENT_TIMERS][LATENCY_BUCKETS]{};
+};
+
+StatsSink &DefaultInstrumentSink();
+InstrumentSink *ActiveInstrumentSink();
+InstrumentSink *SetInstrumentSink(InstrumentSink *sink);
+const char *InstrumentCounterName(InstrumentCounter counter);
+const char *InstrumentTimerName(InstrumentTimer timer);
+
+#if RASTERFONT_INSTRUMENT
+/**
+ * @brief Reports the latency of the enclosing scope to the active sink
+ */
+class InstrumentScope
+{
+public:
+    explicit InstrumentScope(InstrumentTimer timer) : m_timer{timer}, m_start{std::chrono::steady_clock::now()} {}
+    ~InstrumentScope()
+    {
+        ActiveInstrumentSink()->Latency(m_timer, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count());
+    }
+
+private:
+    InstrumentTimer m_timer;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#define INSTRUMENT_COUNT(counter, n) ActiveInstrumentSink()->Count(counter, n)
+#define INSTRUMENT_LATENCY(timer) InstrumentScope instrument_scope(timer)
+#else
+#define INSTRUMENT_COUNT(counter, n) ((void)0)
+#define INSTRUMENT_LATENCY(timer) ((void)0)
+#endif
+
+#endif /* INCLUDE_INSTRUMENT_H_ */
@@ -0,0 +1,95 @@
+/*
+ Raster-Font Library Marquee
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_MARQUEE_H_
+#define INCLUDE_MARQUEE_H_
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FontManager.h"
+
+/**
+ * @brief Scrolls an unbounded stream of text through a window, a column at a time
+ *
+ * Text is pushed onto the stream as it arrives and scrolls in from the right.
+ * Only the glyphs on screen are held, rasterized once each into a ring buffer as
+ * they scroll in and dropped as they scroll out, so a step costs in proportion to
+ * the columns it produces, not to the length of the text. When the stream runs
+ * dry blank columns scroll in until more text is pushed. Text for UTF-8 font
+ * managers is mapped to the font as it is pushed; wide fonts are not supported.
+ *
+ * Output is in the raster of the font manager: the newly exposed columns for
+ * PTBLR displays that scroll in hardware or by page column, or the whole shifted
+ * row window for LRTB frame buffers. Color glyphs are copied whole, their
+ * background included, over a window cleared to the background color. Gray
+ * glyphs are ORed in a packed pixel at a time.
+ *
+ * Glyphs scroll along their rows, so the font manager must be upright (T); a
+ * marquee on a turned font manager holds nothing and produces no output.
+ */
+class Marquee
+{
+public:
+    Marquee(FontManager &fm, uint16_t window_pixels, uint16_t bitOffset = 0);
+
+    void Push(std::string_view text);
+    size_t Pending() const;
+    uint16_t WindowPixels() const;
+    void Step(uint16_t columns);
+    bool Columns(uint16_t columns, FontManager::BitmapView &view);
+    bool Window(FontManager::BitmapView &view);
+
+private:
+    /**
+     * @brief A glyph in the ring, its bitmap in the slot of the same index
+     */
+    struct Glyph
+    {
+        uint8_t width;    ///< Pixels of bitmap, 0 for blank
+        uint8_t advance;  ///< Pixels to the next glyph, "C" spacing included
+        uint16_t stride;  ///< Bytes from one row or page of the bitmap to the next
+        uint16_t rows;    ///< Rows or pages of the bitmap as laid out
+    };
+
+    FontManager &m_fm;                  ///< The font and raster
+    const FontManager::Raster m_raster; ///< Raster direction of the output
+    const uint16_t m_window;            ///< Window width in pixels
+    const uint16_t m_bitOffset;         ///< Position offset of the output
+    const bool m_upright;               ///< The font manager is upright, else the marquee is inert
+    uint8_t m_narrowest{1};             ///< The narrowest advance of the font
+    uint8_t m_blank{1};                 ///< Advance of a blank glyph, the widest advance of the font
+    size_t m_slot_bytes{0};             ///< Bitmap bytes of a slot
+    std::vector<Glyph> m_glyphs;        ///< Ring of the glyphs on screen
+    std::vector<uint8_t> m_bitmaps;     ///< Ring of their bitmaps
+    size_t m_head{0};                   ///< Ring index of the leftmost glyph
+    size_t m_count{0};                  ///< Glyphs in the ring
+    uint16_t m_skip{0};                 ///< Columns of the leftmost glyph scrolled out
+    uint32_t m_span{0};                 ///< Advance of the glyphs in the ring
+    std::string m_pending;              ///< Stream text not yet scrolled in, as font bytes
+    std::string m_partial;              ///< UTF-8 text of a character cut off at the end of a push
+    std::string m_text;                 ///< The font bytes of the last UTF-8 text mapped
+    size_t m_read{0};                   ///< First character of the pending text
+
+    void Fill(uint32_t pixels);
+    void Render(uint16_t from, uint16_t columns, FontManager::BitmapView &view);
+};
+
+#endif /* INCLUDE_MARQUEE_H_ */
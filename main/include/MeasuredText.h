@@ -0,0 +1,93 @@
+/*
+ Raster-Font Library Measured Text
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_MEASUREDTEXT_H_
+#define INCLUDE_MEASUREDTEXT_H_
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FontManager.h"
+
+/**
+ * @brief The advance of each character of a font, for measuring text a character at a time
+ *
+ * The advance is the character width plus the font "C" spacing, with no
+ * spacing after a null, as MeasureString. Text for UTF-8 font managers is
+ * mapped to the font as MeasureString maps it, each character advancing at its
+ * first byte and the bytes continuing it advancing nothing, so offsets stay by
+ * byte of the UTF-8 text. Wide fonts are not supported.
+ */
+class CharAdvances
+{
+public:
+    explicit CharAdvances(FontManager &fm);
+
+    bool Continues(char byte) const;
+    size_t CharStart(std::string_view text, size_t pos) const;
+    uint32_t Offsets(std::string_view text, uint32_t offset, uint32_t *offsets);
+
+private:
+    FontManager &m_fm;          ///< The font and its UTF-8 mapping
+    const bool m_utf8;          ///< Text is UTF-8, as the font manager was when tabulated
+    uint8_t m_advance[256];     ///< Advance of each character, width plus "C"
+    std::string m_bytes;        ///< The font bytes of the last UTF-8 text measured
+    std::vector<size_t> m_starts; ///< The text position of each of those bytes
+};
+
+/**
+ * @brief Text with the horizontal pixel offset of every character, for repeated measuring
+ *
+ * The advance of each character, its width plus the font "C" spacing, is summed
+ * once into a prefix array, so substring widths are a subtraction and pixel hit
+ * tests a binary search. Edits splice the advances of the changed characters in
+ * and shift the offsets after them, without re-measuring the rest of the text.
+ * Widths match FontManager::MeasureString, including the spacing after the last
+ * character. For UTF-8 font managers positions are bytes of the UTF-8 text, as
+ * FontManager::CharacterBreaks gives, and edits and breaks fall on character starts.
+ */
+class MeasuredText
+{
+public:
+    explicit MeasuredText(FontManager &fm, std::string_view text = std::string_view());
+
+    std::string_view Text() const;
+    size_t Size() const;
+    uint32_t Width() const;
+    uint32_t Width(size_t begin, size_t end) const;
+    uint32_t Offset(size_t pos) const;
+    size_t CharAt(uint32_t pixel) const;
+    size_t CaretAt(uint32_t pixel) const;
+    std::vector<uint32_t> Breaks(uint16_t pixels) const;
+
+    void Assign(std::string_view text);
+    void Insert(size_t pos, std::string_view str);
+    void Erase(size_t pos, size_t count);
+
+private:
+    uint8_t m_c;                    ///< The font "C" spacing
+    CharAdvances m_advances;        ///< Advance of each character
+    std::string m_text;             ///< The text
+    std::vector<uint32_t> m_offset; ///< Pixel offset of each character, and the total width last
+
+    uint32_t BreakEdge(size_t pos) const;
+};
+
+#endif /* INCLUDE_MEASUREDTEXT_H_ */
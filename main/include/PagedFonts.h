@@ -0,0 +1,40 @@
+/*
+ Raster-Font Library Paged Fonts
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_PAGEDFONTS_H_
+#define INCLUDE_PAGEDFONTS_H_
+
+#include <stdint.h>
+
+#include "fonts.h"
+
+/**
+ * @brief Font characters rasterized T-B/L-R at compile time
+ *
+ * Each character is stored page after page, a page being one byte per
+ * column with the LSB at the top, for a height offset of zero.
+ */
+typedef struct _paged_font_info
+{
+    const uint8_t *pages;    ///< Paged character data
+    const uint16_t *offsets; ///< Offset of each character in pages, indexed as the font char_descriptors
+} paged_font_info_t;
+
+extern const paged_font_info_t *paged_fonts[NUM_FONTS]; ///< Paged rasters of fonts[], nullptr where not baked
+
+#endif /* INCLUDE_PAGEDFONTS_H_ */
@@ -0,0 +1,67 @@
+/*
+ Raster-Font Library Parallel Rasterizer
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_PARALLELRASTERIZER_H_
+#define INCLUDE_PARALLELRASTERIZER_H_
+
+#include <stdint.h>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "FontManager.h"
+#include "WorkStealingPool.h"
+
+/**
+ * @brief Rasterizes large documents into page images across a thread pool
+ *
+ * The document is split into chunks of whole lines that are wrapped to the page
+ * width in parallel, then the wrapped lines are laid out onto pages and the pages
+ * rasterized in parallel, each straight into its page image. Each worker has its
+ * own FontManager over the shared, immutable font data. Pages are returned in
+ * document order.
+ */
+class ParallelRasterizer
+{
+public:
+    /**
+     * @brief A rasterized page image
+     */
+    struct Page
+    {
+        std::vector<uint8_t> data;     ///< Page image, bytes_per_column rows (LRTB, color and gray) or pages (PTBLR) of stride bytes
+        uint16_t stride{0};            ///< Bytes per row or page
+        uint16_t bytes_per_column{0};  ///< Rows or pages in the image
+        uint32_t first_line{0};        ///< Index of the first wrapped line on the page
+        uint16_t lines{0};             ///< Wrapped lines on the page
+    };
+
+    ParallelRasterizer(uint8_t fontIndex, FontManager::Raster raster, unsigned threads = 0);
+
+    unsigned Threads() const;
+    uint64_t Steals() const;
+    std::vector<std::string_view> Wrap(std::string_view document, uint16_t width_pixels);
+    std::vector<Page> Rasterize(std::string_view document, uint16_t width_pixels, uint16_t height_pixels);
+
+private:
+    const FontManager::Raster m_raster;                   ///< Raster direction of the pages
+    WorkStealingPool m_pool;                              ///< The workers
+    std::vector<std::unique_ptr<FontManager>> m_managers; ///< Font manager of each worker
+};
+
+#endif /* INCLUDE_PARALLELRASTERIZER_H_ */
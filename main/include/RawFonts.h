@@ -0,0 +1,111 @@
+/*
+ Raster-Font Library Raw Fonts
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_RAWFONTS_H_
+#define INCLUDE_RAWFONTS_H_
+
+#include <stddef.h>
+
+#include "fonts.h"
+
+/**
+ * The fonts to bake compressed glyphs for, as a comma separated list of font
+ * names, or "all". A compressed font is rasterized from its compressed glyphs,
+ * and with RASTERFONT_COMPRESSED_TABLES its raw bitmap is left out of the build.
+ */
+#ifndef RASTERFONT_COMPRESSED_FONTS
+#define RASTERFONT_COMPRESSED_FONTS ""
+#endif
+
+/*
+ * The font tables as constant expressions, used only to derive other rasters
+ * and encodings of the fonts at compile time so are not emitted a second time.
+ */
+namespace raw
+{
+#include "font_bitocra_4x7_ascii.h"
+#include "font_bitocra_6x11_iso8859_1.h"
+#include "font_bitocra_7x13_iso8859_1.h"
+#include "font_glcd_5x7.h"
+#include "font_roboto_8pt_ascii.h"
+#include "font_roboto_10pt_ascii.h"
+#include "font_tahoma_8pt_ascii.h"
+#include "font_terminus_6x12_iso8859_1.h"
+#include "font_terminus_8x14_iso8859_1.h"
+#include "font_terminus_10x18_iso8859_1.h"
+#include "font_terminus_11x22_iso8859_1.h"
+#include "font_terminus_12x24_iso8859_1.h"
+#include "font_terminus_14x28_iso8859_1.h"
+#include "font_terminus_16x32_iso8859_1.h"
+#include "font_terminus_bold_8x14_iso8859_1.h"
+#include "font_terminus_bold_10x18_iso8859_1.h"
+#include "font_terminus_bold_11x22_iso8859_1.h"
+#include "font_terminus_bold_12x24_iso8859_1.h"
+#include "font_terminus_bold_14x28_iso8859_1.h"
+#include "font_terminus_bold_16x32_iso8859_1.h"
+#include "font_terminus_6x12_koi8_r.h"
+#include "font_terminus_8x14_koi8_r.h"
+#include "font_terminus_14x28_koi8_r.h"
+#include "font_terminus_16x32_koi8_r.h"
+#include "font_terminus_bold_8x14_koi8_r.h"
+#include "font_terminus_bold_14x28_koi8_r.h"
+#include "font_terminus_bold_16x32_koi8_r.h"
+} // namespace raw
+
+/**
+ * @brief Is the named font in a list of fonts to bake
+ *
+ * @param list a comma separated list of font names, or "all"
+ * @param name the font name
+ * @return true if the font is to be baked
+ */
+constexpr bool bakeFont(const char *list, const char *name)
+{
+    const char *start = list;
+
+    for (const char *all = "all"; *all == *list; all++, list++)
+    {
+        if (!*all)
+            return true;
+    }
+
+    for (list = start; *list;)
+    {
+        const char *n = name;
+        while (*n && *n == *list)
+        {
+            n++;
+            list++;
+        }
+        if (!*n && (!*list || *list == ','))
+            return true;
+        while (*list && *list++ != ',')
+            ;
+    }
+    return false;
+} // bakeFont
+
+/**
+ * @brief The number of characters in the font
+ */
+constexpr size_t charCount(const font_info_t &font)
+{
+    return font.char_end - font.char_start + 1;
+} // charCount
+
+#endif /* INCLUDE_RAWFONTS_H_ */
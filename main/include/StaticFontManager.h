@@ -0,0 +1,196 @@
+/*
+ Raster-Font Library Static Font Manager
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_STATICFONTMANAGER_H_
+#define INCLUDE_STATICFONTMANAGER_H_
+
+#include <stdint.h>
+#include <string_view>
+
+#include "BitTranspose.h"
+#include "FontManager.h"
+#include "FontTags.h"
+#include "Instrument.h"
+#include "PagedFonts.h"
+
+/**
+ * @brief The string entry points of a font and raster, selected once by a FontManager
+ */
+struct FontEngine
+{
+    FontManager::XY (*measure_string)(std::string_view str);                       ///< Horizontal string dimensions
+    void (*raster_string)(std::string_view str, FontManager::BitmapView &view);    ///< OR a string into a laid out view
+};
+
+const FontEngine *FontEngineFor(uint8_t fontIndex, FontManager::Raster raster);
+const paged_font_info_t *PagedFontOf(const font_info_t *font);
+
+/**
+ * @brief Font manager fixed at compile time to one font and raster
+ *
+ * Height, character range, "C" spacing and raster path are constants, so the
+ * per row loops unroll and there is no raster branch per character. Stateless;
+ * PTBLR uses the baked paged font if there is one, else transposes on the fly.
+ * FontManager dispatches to these for the font and raster it is instantiated with.
+ *
+ * @tparam Font the font tag, from FontTags
+ * @tparam R the raster direction
+ */
+template <typename Font, FontManager::Raster R>
+class StaticFontManager
+{
+public:
+    static constexpr uint8_t pages = ((Font::height - 1) / 8) + 1;              ///< Pages of a PTBLR character
+    static constexpr uint8_t max_read_bytes = ((Font::max_width - 1) / 8) + 1;  ///< Most font bytes in a character row
+
+    /**
+     * @brief The descriptor index of a character, unknown characters becoming space or the first character
+     */
+    static constexpr unsigned char CharIndex(unsigned char c)
+    {
+        bool unknown = c < Font::char_start;
+        if constexpr (Font::char_end < 0xFF)
+            unknown = unknown || c > Font::char_end;
+        if (unknown)
+            c = (' ' < Font::char_start) ? Font::char_start : ' ';
+        return c - Font::char_start;
+    } // CharIndex
+
+    /**
+     * @brief The dimensions of a horizontal string
+     */
+    static FontManager::XY MeasureString(std::string_view str)
+    {
+        FontManager::XY xy;
+
+        for (unsigned char c : str)
+        {
+            xy.x_pixels += Font::info.char_descriptors[CharIndex(c)].width;
+            if (c) // Add kerning
+                xy.x_pixels += Font::c;
+        }
+        if (xy.x_pixels)
+            xy.y_pixels = Font::height;
+        return xy;
+    } // MeasureString
+
+    /**
+     * @brief Bitmaps a string into a caller owned buffer, as FontManager::RasterizeInto
+     */
+    static bool RasterizeInto(std::string_view str, FontManager::BitmapView &view, uint16_t bitOffset = 0)
+    {
+        if (!FontManager::PrepareView(view, R, MeasureString(str), bitOffset))
+            return false;
+
+        RasterString(str, view);
+        return true;
+    } // RasterizeInto
+
+    /**
+     * @brief ORs a string into a laid out view from its bit-point
+     */
+    static void RasterString(std::string_view str, FontManager::BitmapView &view)
+    {
+        const paged_font_info_t *paged = nullptr;
+        if constexpr (R == FontManager::PTBLR)
+            paged = Paged();
+
+        for (unsigned char c : str)
+        {
+            RasterChar(CharIndex(c), view, paged);
+        }
+    } // RasterString
+
+private:
+    /**
+     * @brief The baked paged raster of the font, if any
+     */
+    static const paged_font_info_t *Paged()
+    {
+        static const paged_font_info_t *const paged = PagedFontOf(&Font::info);
+        return paged;
+    } // Paged
+
+    /**
+     * @brief ORs the rows of a character Bytes bytes wide, or narrower, into a LRTB view
+     */
+    template <uint8_t Bytes>
+    static void RowsLRTB(const uint8_t *char_bitmap, uint8_t read_bytes, uint8_t *dest, uint16_t stride, uint8_t right_shift)
+    {
+        if constexpr (Bytes > 1)
+        {
+            if (read_bytes < Bytes)
+                return RowsLRTB<Bytes - 1>(char_bitmap, read_bytes, dest, stride, right_shift);
+        }
+
+        for (uint8_t row = 0; row < Font::height; row++, dest += stride)
+        {
+            uint8_t *pixel = dest;
+            for (uint8_t column = 0; column < Bytes; column++)
+            {
+                uint8_t word = *char_bitmap++;
+                *pixel++ |= (word >> right_shift);
+                if (right_shift)
+                {
+                    uint8_t spill = word << (8 - right_shift);
+                    if (spill)
+                        *pixel |= spill;
+                }
+            }
+        }
+    } // RowsLRTB
+
+    /**
+     * @brief ORs a character into the view at its bit-point and advances the bit-point
+     */
+    static void RasterChar(unsigned char c, FontManager::BitmapView &bm, const paged_font_info_t *paged)
+    {
+        font_char_desc_t char_desc = Font::info.char_descriptors[c];
+        const uint8_t *char_bitmap = Font::info.bitmap + char_desc.offset;
+
+        if constexpr (R == FontManager::LRTB)
+        {
+            RowsLRTB<max_read_bytes>(char_bitmap, 1 + ((char_desc.width - 1) / 8), bm.data + (bm.bitpoint / 8), bm.stride, bm.bitpoint % 8);
+        }
+        else if (paged)
+        {
+            INSTRUMENT_COUNT(COUNT_PAGED_GLYPHS, 1);
+            uint8_t phase = bm.height_offset_pixels;
+            const uint8_t *columns = paged->pages + paged->offsets[c];
+            for (uint8_t page = 0; page < pages; page++)
+            {
+                uint8_t *pixel = bm.data + (bm.stride * page) + bm.bitpoint;
+                for (uint8_t seg = 0; seg < char_desc.width; seg++)
+                {
+                    uint8_t column = *columns++;
+                    pixel[seg] |= column << phase;
+                    if (phase && (column >> (8 - phase)))
+                        pixel[seg + bm.stride] |= column >> (8 - phase);
+                }
+            }
+        }
+        else
+        {
+            TransposeChar(char_bitmap, char_desc.width, Font::height, bm.height_offset_pixels, bm.data + bm.bitpoint, bm.stride);
+        }
+
+        bm.bitpoint += char_desc.width + Font::c;
+    } // RasterChar
+};
+
+#endif /* INCLUDE_STATICFONTMANAGER_H_ */
@@ -0,0 +1,88 @@
+/*
+ Raster-Font Library Text Layout
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_TEXTLAYOUT_H_
+#define INCLUDE_TEXTLAYOUT_H_
+
+#include <stdint.h>
+#include <string_view>
+#include <vector>
+
+#include "FontManager.h"
+#include "MeasuredText.h"
+
+/**
+ * @brief Word wraps text into lines of a pixel width
+ *
+ * Lines break between words, dropping the spaces, or after a hyphen within a
+ * word, and always at a newline. Words wider than a line are broken between
+ * characters. Each line fits the width as measured by MeasureString, so
+ * rasterizes to no more than the width. Text for UTF-8 font managers is
+ * measured as MeasureString maps it, lines being spans of the UTF-8 bytes.
+ */
+class TextLayout
+{
+public:
+    /**
+     * @brief How lines are filled
+     */
+    enum Mode
+    {
+        GREEDY,         ///< As many words as fit on each line in turn
+        MIN_RAGGEDNESS, ///< Minimum sum of squared slack over each paragraph but its last line, Knuth-Plass style
+    };
+
+    /**
+     * @brief A line of the text
+     */
+    struct Line
+    {
+        uint32_t begin;         ///< First character
+        uint32_t end;           ///< One past the last character
+        uint32_t width_pixels;  ///< Width as measured by MeasureString
+    };
+
+    explicit TextLayout(FontManager &fm);
+
+    std::vector<Line> Wrap(std::string_view text, uint16_t pixels, Mode mode = GREEDY);
+
+private:
+    /**
+     * @brief Characters that stay together on a line, between break opportunities
+     */
+    struct Box
+    {
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    CharAdvances m_advances;         ///< Advance of each character
+    uint32_t m_base{0};              ///< First character of the paragraph
+    std::vector<uint32_t> m_offset;  ///< Pixel offset of each character of the paragraph
+    std::vector<Box> m_boxes;        ///< Boxes of the paragraph
+    std::vector<uint64_t> m_cost;    ///< Least cost of laying out the first boxes
+    std::vector<uint32_t> m_from;    ///< First box of the last line of that layout
+
+    uint32_t Width(const Box &first, const Box &last) const;
+    void AddBox(std::string_view text, uint32_t begin, uint32_t end, uint16_t pixels);
+    void Boxes(std::string_view text, uint32_t begin, uint32_t end, uint16_t pixels);
+    void Greedy(std::vector<Line> &lines, uint16_t pixels);
+    void MinRaggedness(std::vector<Line> &lines, uint16_t pixels);
+};
+
+#endif /* INCLUDE_TEXTLAYOUT_H_ */
@@ -0,0 +1,78 @@
+/*
+ Raster-Font Library Work Stealing Pool
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef INCLUDE_WORKSTEALINGPOOL_H_
+#define INCLUDE_WORKSTEALINGPOOL_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads running indexed tasks
+ *
+ * Each worker has its own task queue, taking from its back, and steals from the
+ * front of the other queues when its own is empty, so uneven tasks balance out.
+ * Tasks are told which worker runs them so they can use per-worker state.
+ */
+class WorkStealingPool
+{
+public:
+    typedef std::function<void(size_t task, unsigned worker)> Task; ///< Task body
+
+    explicit WorkStealingPool(unsigned threads = 0);
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+    ~WorkStealingPool();
+
+    unsigned Threads() const;
+    uint64_t Steals() const;
+    void ParallelFor(size_t count, const Task &task);
+
+private:
+    /**
+     * @brief A worker's task queue
+     */
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    std::vector<std::thread> m_threads;           ///< The workers
+    std::vector<std::unique_ptr<Queue>> m_queues; ///< Task queue of each worker
+    std::mutex m_mutex;                           ///< Guards the generation and completion
+    std::condition_variable m_wake;               ///< Signals workers a new generation of tasks
+    std::condition_variable m_done;               ///< Signals the caller all tasks are complete
+    uint64_t m_generation{0};                     ///< Incremented for each ParallelFor
+    bool m_stop{false};                           ///< Workers exit
+    std::atomic<const Task *> m_task{nullptr};    ///< The running task body
+    std::atomic<size_t> m_pending{0};             ///< Tasks not yet complete
+    std::atomic<uint64_t> m_steals{0};            ///< Tasks taken from another worker's queue
+
+    void Work(unsigned worker);
+    bool Take(unsigned worker, size_t &task);
+};
+
+#endif /* INCLUDE_WORKSTEALINGPOOL_H_ */
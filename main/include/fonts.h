@@ -34,6 +34,12 @@
 
 #include <stdint.h>
 
+#ifdef __cplusplus
+#define FONT_DATA constexpr //!< Font tables are constant expressions to C++, to derive other rasters at compile time
+#else
+#define FONT_DATA const
+#endif
+
 //!< @brief Character descriptor
 typedef struct _font_char_desc
 {
@@ -53,6 +59,45 @@ typedef struct _font_info
         const uint8_t *bitmap;    //!< Character bitmap
 } font_info_t;
 
+#define WIDE_NO_BLOCK 0xFFFF    //!< Block index entry of 256 code points without characters
+
+//!< @brief Wide character descriptor
+typedef struct _wide_char_desc
+{
+        uint32_t offset;    //!< Offset of this character in bitmap
+        uint8_t width;      //!< Character width in pixel
+} wide_char_desc_t;
+
+//!< @brief The characters of a block of 256 code points
+typedef struct _wide_char_block
+{
+        uint32_t first;         //!< Descriptor index of the first character in the block
+        uint32_t present[8];    //!< Bit per code point of the block with a character, LSB first
+} wide_char_block_t;
+
+//! @brief Wide font information, characters by Unicode code point
+typedef struct _wide_font_info
+{
+        font_info_t info;       //!< Name, height, "C" and bitmap; the character range and descriptors are unused
+        uint32_t default_code;  //!< Character shown for code points without one
+        uint32_t char_count;    //!< Number of characters
+        uint32_t block_count;   //!< Entries of the block index, covering code points below block_count * 256
+        const uint16_t *block_index;                //!< Block of each 256 code points, or WIDE_NO_BLOCK
+        const wide_char_block_t *blocks;            //!< The blocks with characters
+        const wide_char_desc_t *char_descriptors;   //!< descriptor for each character, in code point order
+} wide_font_info_t;
+
+#define SUBSET_NO_CHAR 0xFF     //!< Remap entry of a character dropped from a subset font
+
+//! @brief Subset font information, the characters kept from a font and the remap of its character codes
+typedef struct _subset_font_info
+{
+        font_info_t info;               //!< The kept characters, numbered from 0
+        unsigned char code_start;       //!< First character code of the original font
+        unsigned char code_end;         //!< Last character code of the original font
+        const uint8_t *remap;           //!< Kept character of each code from code_start, SUBSET_NO_CHAR if dropped, null for whole fonts
+} subset_font_info_t;
+
 
 extern const font_info_t * fonts [ NUM_FONTS ];    //!< Built-in fonts
 
@@ -0,0 +1,1193 @@
+/*
+ Raster-Font Library Font Import
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+
+#include "FontImport.h"
+#include "FontPack.h"
+
+/*
+ * PCF table types and format bits, as the X11 pcf reader
+ */
+#define PCF_FILE_VERSION 0x70636601 ///< "\1fcp" read little-endian
+#define PCF_PROPERTIES (1 << 0)
+#define PCF_ACCELERATORS (1 << 1)
+#define PCF_METRICS (1 << 2)
+#define PCF_BITMAPS (1 << 3)
+#define PCF_BDF_ENCODINGS (1 << 5)
+#define PCF_BDF_ACCELERATORS (1 << 8)
+#define PCF_COMPRESSED_METRICS 0x00000100
+#define PCF_FORMAT_MASK 0xFFFFFF00
+#define PCF_GLYPH_PAD_MASK (3 << 0)
+#define PCF_BYTE_MASK (1 << 2) ///< Set for most significant byte first
+#define PCF_BIT_MASK (1 << 3)  ///< Set for most significant bit first
+#define PCF_SCAN_UNIT_MASK (3 << 4)
+#define PCF_NO_GLYPH 0xFFFF
+
+/**
+ * @brief Is a pixel of the box inked
+ *
+ * @param x the column from the left of the box
+ * @param y the row from the top of the box
+ * @return true if inked, false if outside the box
+ */
+bool SourceGlyph::Pixel(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= width || y >= height)
+        return false;
+    int row_bytes = (width + 7) / 8;
+    return rows[(y * row_bytes) + (x / 8)] & (0x80 >> (x % 8));
+} // Pixel
+
+/**
+ * @brief A view of the font as the library uses it
+ *
+ * @return the font info, valid while the imported font is unchanged
+ */
+font_info_t ImportedFont::Info() const
+{
+    return {name.c_str(), height, c, char_start, char_end, descriptors.data(), bitmap.data()};
+} // Info
+
+/**
+ * @brief A view of the wide font as the library uses it
+ *
+ * @return the font info, valid while the imported font is unchanged
+ */
+wide_font_info_t ImportedWideFont::Info() const
+{
+    return {{name.c_str(), height, c, 0, 0, nullptr, bitmap.data()}, default_code, (uint32_t)descriptors.size(),
+            (uint32_t)block_index.size(), block_index.data(), blocks.data(), descriptors.data()};
+} // Info
+
+/**
+ * @brief A view of the subset font as the library uses it
+ *
+ * @return the font info, valid while the subset is unchanged
+ */
+subset_font_info_t FontSubset::Info() const
+{
+    return {font.Info(), code_start, code_end, remap.data()};
+} // Info
+
+/**
+ * @brief Reads a whole file
+ */
+static bool readFile(const std::string &path, std::string &data, std::string &error)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+} // readFile
+
+/**
+ * @brief The file name without directories or extensions
+ */
+static std::string stem(const std::string &path)
+{
+    std::string name = path.substr(path.find_last_of('/') + 1);
+    return name.substr(0, name.find('.'));
+} // stem
+
+/**
+ * @brief Reads a BDF 2.1 font
+ *
+ * @param path the font file
+ * @param font the glyphs read
+ * @param error why the font could not be read
+ * @return false if the file is not a readable BDF font
+ */
+bool ReadBDF(const std::string &path, SourceFont &font, std::string &error)
+{
+    std::string data;
+    if (!readFile(path, data, error))
+        return false;
+
+    std::istringstream in(data);
+    std::string line, keyword;
+    SourceGlyph glyph;
+    bool in_char = false, bounding_box = false;
+    int box_ascent = 0, box_descent = 0;
+    int64_t encoding = -1;
+
+    font = SourceFont();
+    font.name = stem(path);
+    font.ascent = font.descent = -1;
+
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        keyword.clear();
+        fields >> keyword;
+
+        if (keyword == "FONTBOUNDINGBOX")
+        {
+            int w, h, x, y;
+            if (fields >> w >> h >> x >> y)
+            {
+                box_ascent = h + y;
+                box_descent = -y;
+                bounding_box = true;
+            }
+        }
+        else if (keyword == "FONT_ASCENT")
+            fields >> font.ascent;
+        else if (keyword == "FONT_DESCENT")
+            fields >> font.descent;
+        else if (keyword == "DEFAULT_CHAR")
+            fields >> font.default_code;
+        else if (keyword == "STARTCHAR")
+        {
+            glyph = SourceGlyph();
+            encoding = -1;
+            in_char = true;
+        }
+        else if (in_char && keyword == "ENCODING")
+            fields >> encoding;
+        else if (in_char && keyword == "DWIDTH")
+            fields >> glyph.advance;
+        else if (in_char && keyword == "BBX")
+            fields >> glyph.width >> glyph.height >> glyph.x_offset >> glyph.y_offset;
+        else if (in_char && keyword == "BITMAP")
+        /*
+         * Hex rows of the box, each whole bytes
+         */
+        {
+            int row_bytes = (glyph.width + 7) / 8;
+            if (glyph.width < 0 || glyph.height < 0)
+            {
+                error = path + ": bad BBX";
+                return false;
+            }
+            glyph.rows.assign((size_t)row_bytes * glyph.height, 0);
+            for (int row = 0; row < glyph.height && std::getline(in, line); row++)
+            {
+                for (int b = 0; b < row_bytes && (size_t)(b * 2) + 1 < line.size() + 1; b++)
+                {
+                    std::string hex = line.substr(b * 2, 2);
+                    glyph.rows[(row * row_bytes) + b] = strtoul(hex.c_str(), nullptr, 16);
+                }
+            }
+        }
+        else if (in_char && keyword == "ENDCHAR")
+        {
+            if (encoding >= 0)
+            {
+                glyph.code = encoding;
+                font.glyphs.push_back(glyph);
+            }
+            in_char = false;
+        }
+    }
+
+    if (!bounding_box && (font.ascent < 0 || font.descent < 0))
+    {
+        error = path + ": no FONTBOUNDINGBOX or FONT_ASCENT and FONT_DESCENT";
+        return false;
+    }
+    if (font.ascent < 0)
+        font.ascent = box_ascent;
+    if (font.descent < 0)
+        font.descent = box_descent;
+    if (font.glyphs.empty())
+    {
+        error = path + ": no glyphs";
+        return false;
+    }
+    return true;
+} // ReadBDF
+
+namespace
+{
+
+/**
+ * @brief Reads values from a PCF table in its byte order
+ */
+struct PcfReader
+{
+    const std::string &data;
+    size_t pos;
+    bool msb_first;
+    bool ok{true};
+
+    uint32_t Bytes(int n)
+    {
+        if (pos + n > data.size())
+        {
+            ok = false;
+            return 0;
+        }
+        uint32_t value = 0;
+        for (int i = 0; i < n; i++)
+        {
+            uint8_t byte = data[pos + (msb_first ? i : n - 1 - i)];
+            value = (value << 8) | byte;
+        }
+        pos += n;
+        return value;
+    }
+    size_t Remaining() const { return (pos < data.size()) ? data.size() - pos : 0; }
+    int32_t Int32() { return (int32_t)Bytes(4); }
+    int16_t Int16() { return (int16_t)Bytes(2); }
+    uint8_t Byte() { return Bytes(1); }
+};
+
+/**
+ * @brief A PCF table of contents entry
+ */
+struct PcfTable
+{
+    uint32_t type;
+    uint32_t format;
+    uint32_t size;
+    uint32_t offset;
+};
+
+/**
+ * @brief The reader at the start of a table's data, after its format
+ */
+bool pcfTable(const std::string &data, const std::vector<PcfTable> &tables, uint32_t type, PcfReader &reader, uint32_t &format)
+{
+    for (const PcfTable &table : tables)
+    {
+        if (table.type != type)
+            continue;
+        PcfReader lsb{data, table.offset, false};
+        format = lsb.Int32(); // Always little-endian
+        reader.pos = lsb.pos;
+        reader.msb_first = format & PCF_BYTE_MASK;
+        reader.ok = lsb.ok;
+        return reader.ok;
+    }
+    return false;
+} // pcfTable
+
+} // namespace
+
+/**
+ * @brief Reads an uncompressed PCF font, as bdftopcf writes
+ *
+ * @param path the font file
+ * @param font the glyphs read
+ * @param error why the font could not be read
+ * @return false if the file is not a readable PCF font
+ */
+bool ReadPCF(const std::string &path, SourceFont &font, std::string &error)
+{
+    std::string data;
+    if (!readFile(path, data, error))
+        return false;
+
+    font = SourceFont();
+    font.name = stem(path);
+
+    PcfReader toc{data, 0, false};
+    if (toc.Bytes(4) != PCF_FILE_VERSION)
+    {
+        error = path + ": not a PCF font (gzipped fonts must be unzipped first)";
+        return false;
+    }
+    int32_t table_count = toc.Int32();
+    if (table_count < 0 || (size_t)table_count > toc.Remaining() / 16) // Type, format, size and offset
+    {
+        error = path + ": truncated table of contents";
+        return false;
+    }
+    std::vector<PcfTable> tables(table_count);
+    for (PcfTable &table : tables)
+    {
+        table.type = toc.Bytes(4);
+        table.format = toc.Bytes(4);
+        table.size = toc.Bytes(4);
+        table.offset = toc.Bytes(4);
+    }
+
+    PcfReader in{data, 0, false};
+    uint32_t format = 0;
+
+    /*
+     * Ascent and descent
+     */
+    if (pcfTable(data, tables, PCF_BDF_ACCELERATORS, in, format) || pcfTable(data, tables, PCF_ACCELERATORS, in, format))
+    {
+        in.pos += 8; // Flags and padding
+        font.ascent = in.Int32();
+        font.descent = in.Int32();
+    }
+    else
+    {
+        error = path + ": no accelerator table";
+        return false;
+    }
+
+    /*
+     * Metrics
+     */
+    if (!pcfTable(data, tables, PCF_METRICS, in, format))
+    {
+        error = path + ": no metrics table";
+        return false;
+    }
+    bool compressed = (format & PCF_FORMAT_MASK) == PCF_COMPRESSED_METRICS;
+    size_t count = compressed ? (uint16_t)in.Int16() : (size_t)std::max(in.Int32(), 0);
+    if (count > in.Remaining() / (compressed ? 5 : 12)) // Bytes of each glyph's metrics
+    {
+        error = path + ": truncated metrics";
+        return false;
+    }
+    std::vector<SourceGlyph> glyphs(count);
+    for (SourceGlyph &glyph : glyphs)
+    {
+        int left, right, ascent, descent;
+        if (compressed)
+        {
+            left = in.Byte() - 0x80;
+            right = in.Byte() - 0x80;
+            glyph.advance = in.Byte() - 0x80;
+            ascent = in.Byte() - 0x80;
+            descent = in.Byte() - 0x80;
+        }
+        else
+        {
+            left = in.Int16();
+            right = in.Int16();
+            glyph.advance = in.Int16();
+            ascent = in.Int16();
+            descent = in.Int16();
+            in.Int16(); // Attributes
+        }
+        glyph.width = std::max(right - left, 0);
+        glyph.height = std::max(ascent + descent, 0);
+        glyph.x_offset = left;
+        glyph.y_offset = -descent;
+    }
+
+    /*
+     * Bitmaps, converted to MSB first bytes without padding beyond a byte
+     */
+    if (!pcfTable(data, tables, PCF_BITMAPS, in, format) || (size_t)in.Int32() != count)
+    {
+        error = path + ": no bitmaps for the metrics";
+        return false;
+    }
+    std::vector<uint32_t> offsets(count);
+    for (uint32_t &offset : offsets)
+    {
+        offset = in.Int32();
+    }
+    uint32_t sizes[4];
+    for (uint32_t &size : sizes)
+    {
+        size = in.Int32();
+    }
+    size_t base = in.pos;
+    int pad = 1 << (format & PCF_GLYPH_PAD_MASK);
+    int unit = 1 << ((format & PCF_SCAN_UNIT_MASK) >> 4);
+    bool swap = ((format & PCF_BYTE_MASK) != 0) != ((format & PCF_BIT_MASK) != 0);
+    bool msb_bits = format & PCF_BIT_MASK;
+
+    if (!in.ok || base + sizes[format & PCF_GLYPH_PAD_MASK] > data.size())
+    {
+        error = path + ": truncated bitmaps";
+        return false;
+    }
+
+    for (size_t g = 0; g < count; g++)
+    {
+        SourceGlyph &glyph = glyphs[g];
+        int row_bytes = (glyph.width + 7) / 8;
+        int stride = ((row_bytes + pad - 1) / pad) * pad;
+
+        if (base + offsets[g] + ((size_t)stride * glyph.height) > data.size())
+        {
+            error = path + ": glyph outside the bitmaps";
+            return false;
+        }
+        glyph.rows.assign((size_t)row_bytes * glyph.height, 0);
+        for (int y = 0; y < glyph.height; y++)
+        {
+            const uint8_t *row = reinterpret_cast<const uint8_t *>(data.data()) + base + offsets[g] + ((size_t)y * stride);
+            for (int x = 0; x < glyph.width; x++)
+            {
+                int byte = x / 8;
+                if (swap && unit > 1)
+                    byte = ((byte / unit) * unit) + (unit - 1 - (byte % unit));
+                bool ink = msb_bits ? (row[byte] & (0x80 >> (x % 8))) : (row[byte] & (1 << (x % 8)));
+                if (ink)
+                    glyph.rows[(y * row_bytes) + (x / 8)] |= 0x80 >> (x % 8);
+            }
+        }
+    }
+
+    /*
+     * Encodings
+     */
+    if (!pcfTable(data, tables, PCF_BDF_ENCODINGS, in, format))
+    {
+        error = path + ": no encodings table";
+        return false;
+    }
+    int first_col = in.Int16(), last_col = in.Int16(), first_row = in.Int16(), last_row = in.Int16();
+    font.default_code = (uint16_t)in.Int16();
+    for (int row = first_row; row <= last_row && in.ok; row++)
+    {
+        for (int col = first_col; col <= last_col && in.ok; col++)
+        {
+            uint16_t index = in.Int16();
+            if (index != PCF_NO_GLYPH && index < count)
+            {
+                glyphs[index].code = (row << 8) | col;
+                font.glyphs.push_back(glyphs[index]);
+            }
+        }
+    }
+
+    if (!in.ok || font.glyphs.empty())
+    {
+        error = path + ": truncated or no encoded glyphs";
+        return false;
+    }
+    return true;
+} // ReadPCF
+
+/**
+ * @brief Reads a BDF or PCF font, by its content
+ *
+ * @param path the font file
+ * @param font the glyphs read
+ * @param error why the font could not be read
+ * @return false if the file is not a readable font
+ */
+bool ReadFontFile(const std::string &path, SourceFont &font, std::string &error)
+{
+    char magic[4] = {0};
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    size_t got = fread(magic, 1, sizeof(magic), file);
+    fclose(file);
+
+    if (got == sizeof(magic) && !memcmp(magic, "\1fcp", 4))
+        return ReadPCF(path, font, error);
+    return ReadBDF(path, font, error);
+} // ReadFontFile
+
+/**
+ * @brief Makes a C identifier of lower case letters, digits and underscores
+ *
+ * @param text the text, such as a file name
+ * @return the identifier
+ */
+std::string FontIdentifier(const std::string &text)
+{
+    std::string id;
+    for (char ch : text)
+    {
+        if (isalnum((unsigned char)ch))
+            id += tolower((unsigned char)ch);
+        else if (!id.empty() && id.back() != '_')
+            id += '_';
+    }
+    while (!id.empty() && id.back() == '_')
+        id.pop_back();
+    if (id.empty() || isdigit((unsigned char)id[0]))
+        id = "font_" + id;
+    return id;
+} // FontIdentifier
+
+/**
+ * @brief Lays out glyphs as character bitmaps
+ *
+ * Glyphs are placed in a cell of the font ascent and descent and their advance,
+ * widened to any ink outside it, or trimmed to their ink. Identical glyph
+ * bitmaps are stored once.
+ *
+ * @param source the font read
+ * @param glyphs the glyphs to lay out, in character order
+ * @param options how to lay the glyphs out
+ * @param max_offset the largest bitmap offset the descriptors can hold
+ * @param height the character height
+ * @param descriptors the descriptor of each glyph
+ * @param bitmap the character bitmaps
+ * @param shared the glyphs sharing another's bitmap
+ * @param error why the glyphs cannot be laid out
+ * @return false if a character is too large or the bitmaps exceed the offsets
+ */
+static bool layoutGlyphs(const SourceFont &source, const std::vector<const SourceGlyph *> &glyphs, const ImportOptions &options,
+                         uint32_t max_offset, uint8_t &height, std::vector<wide_char_desc_t> &descriptors,
+                         std::vector<uint8_t> &bitmap, size_t &shared, std::string &error)
+{
+    /*
+     * The rows of the font, from the top of the cell
+     */
+    int top = 0, bottom = source.ascent + source.descent;
+    int ink_top = bottom, ink_bottom = 0;
+    for (const SourceGlyph *glyph : glyphs)
+    {
+        for (int y = 0; y < glyph->height; y++)
+        {
+            for (int x = 0; x < glyph->width; x++)
+            {
+                if (glyph->Pixel(x, y))
+                {
+                    int row = source.ascent - (glyph->y_offset + glyph->height) + y;
+                    ink_top = std::min(ink_top, row);
+                    ink_bottom = std::max(ink_bottom, row + 1);
+                }
+            }
+        }
+    }
+    if (options.trim && ink_top < ink_bottom)
+    {
+        top = ink_top;
+        bottom = ink_bottom;
+    }
+    else
+    {
+        top = std::min(top, ink_top);
+        bottom = std::max(bottom, ink_bottom);
+    }
+    if (bottom - top < 1 || bottom - top > 0xFF)
+    {
+        error = source.name + ": character height out of range";
+        return false;
+    }
+    height = bottom - top;
+
+    std::map<std::vector<uint8_t>, uint32_t> stored; // Bitmap, width prefixed, to its offset
+
+    for (const SourceGlyph *glyph : glyphs)
+    /*
+     * Render each glyph into its cell columns
+     */
+    {
+        int left = std::min(0, glyph->x_offset);
+        int right = std::max(glyph->advance, glyph->x_offset + glyph->width);
+
+        if (options.trim)
+        {
+            int ink_left = right, ink_right = left;
+            for (int y = 0; y < glyph->height; y++)
+            {
+                for (int x = 0; x < glyph->width; x++)
+                {
+                    if (glyph->Pixel(x, y))
+                    {
+                        ink_left = std::min(ink_left, glyph->x_offset + x);
+                        ink_right = std::max(ink_right, glyph->x_offset + x + 1);
+                    }
+                }
+            }
+            if (ink_left < ink_right)
+            {
+                left = ink_left;
+                right = ink_right;
+            }
+            else
+            {
+                left = 0;
+                right = std::max(glyph->advance - options.c, 1); // Blank, such as space, keeps its advance
+            }
+        }
+
+        int width = right - left;
+        if (width < 1 || width > 0xFF)
+        {
+            error = source.name + ": character width out of range";
+            return false;
+        }
+
+        int row_bytes = ((width - 1) / 8) + 1;
+        std::vector<uint8_t> rows(1 + ((size_t)row_bytes * height), 0);
+        rows[0] = width;
+        for (int row = 0; row < height; row++)
+        {
+            int y = (row + top) - (source.ascent - (glyph->y_offset + glyph->height));
+            for (int column = 0; column < width; column++)
+            {
+                if (glyph->Pixel((column + left) - glyph->x_offset, y))
+                    rows[1 + (row * row_bytes) + (column / 8)] |= 0x80 >> (column % 8);
+            }
+        }
+
+        std::map<std::vector<uint8_t>, uint32_t>::iterator same = stored.find(rows);
+        wide_char_desc_t char_desc{};
+        char_desc.width = width;
+        if (options.dedup && same != stored.end())
+        {
+            char_desc.offset = same->second;
+            shared++;
+        }
+        else
+        {
+            if (bitmap.size() > max_offset)
+            {
+                error = source.name + ": bitmaps exceed the character offsets";
+                return false;
+            }
+            char_desc.offset = bitmap.size();
+            stored[rows] = char_desc.offset;
+            bitmap.insert(bitmap.end(), rows.begin() + 1, rows.end());
+        }
+        descriptors.push_back(char_desc);
+    }
+    return true;
+} // layoutGlyphs
+
+/**
+ * @brief Lays out the glyphs of codes 1 to 255 as a font_info_t font
+ *
+ * Characters without a glyph between the first and last take the default
+ * glyph.
+ *
+ * @param source the glyphs read
+ * @param options how to lay the glyphs out
+ * @param font the font
+ * @param error why the font cannot be laid out
+ * @return false if no glyphs are in range or the font exceeds the font_info_t limits
+ */
+bool ImportFont(const SourceFont &source, const ImportOptions &options, ImportedFont &font, std::string &error)
+{
+    std::map<uint32_t, const SourceGlyph *> glyphs;
+    for (const SourceGlyph &glyph : source.glyphs)
+    {
+        if (glyph.code >= 1 && glyph.code <= 0xFF)
+            glyphs[glyph.code] = &glyph;
+    }
+    if (glyphs.empty())
+    {
+        error = source.name + ": no glyphs for codes 1 to 255";
+        return false;
+    }
+
+    std::vector<const SourceGlyph *> ordered;
+    for (const std::pair<const uint32_t, const SourceGlyph *> &entry : glyphs)
+    {
+        ordered.push_back(entry.second);
+    }
+
+    font = ImportedFont();
+    std::vector<wide_char_desc_t> laid_out;
+    if (!layoutGlyphs(source, ordered, options, 0xFFFF, font.height, laid_out, font.bitmap, font.glyphs_shared, error))
+        return false;
+
+    font.name = FontIdentifier(source.name);
+    font.c = options.trim ? options.c : 0;
+    font.char_start = glyphs.begin()->first;
+    font.char_end = glyphs.rbegin()->first;
+
+    /*
+     * Characters without glyphs take the default, space or first glyph
+     */
+    std::map<uint32_t, font_char_desc_t> by_code;
+    size_t i = 0;
+    for (const std::pair<const uint32_t, const SourceGlyph *> &entry : glyphs)
+    {
+        by_code[entry.first] = {laid_out[i].width, (uint16_t)laid_out[i].offset};
+        i++;
+    }
+
+    font_char_desc_t fallback = by_code.begin()->second;
+    if (source.default_code >= 0 && by_code.count(source.default_code))
+        fallback = by_code[source.default_code];
+    else if (by_code.count(' '))
+        fallback = by_code[' '];
+
+    for (unsigned int c = font.char_start; c <= font.char_end; c++)
+    {
+        std::map<uint32_t, font_char_desc_t>::iterator found = by_code.find(c);
+        font.descriptors.push_back((found != by_code.end()) ? found->second : fallback);
+        if (found == by_code.end())
+            font.glyphs_shared++;
+    }
+    return true;
+} // ImportFont
+
+/**
+ * @brief Lays out every glyph as a wide font, indexed by code point
+ *
+ * Codes of the font's encoding are taken as Unicode code points, as in
+ * iso10646-1 fonts.
+ *
+ * @param source the glyphs read
+ * @param options how to lay the glyphs out
+ * @param font the font
+ * @param error why the font cannot be laid out
+ * @return false if there are no glyphs or a character is too large
+ */
+bool ImportWideFont(const SourceFont &source, const ImportOptions &options, ImportedWideFont &font, std::string &error)
+{
+    std::map<uint32_t, const SourceGlyph *> glyphs;
+    for (const SourceGlyph &glyph : source.glyphs)
+    {
+        if (glyph.code >= 1 && glyph.code <= 0x10FFFF)
+            glyphs[glyph.code] = &glyph;
+    }
+    if (glyphs.empty())
+    {
+        error = source.name + ": no glyphs";
+        return false;
+    }
+
+    std::vector<const SourceGlyph *> ordered;
+    for (const std::pair<const uint32_t, const SourceGlyph *> &entry : glyphs)
+    {
+        ordered.push_back(entry.second);
+    }
+
+    font = ImportedWideFont();
+    if (!layoutGlyphs(source, ordered, options, 0xFFFFFFFF, font.height, font.descriptors, font.bitmap, font.glyphs_shared, error))
+        return false;
+
+    font.name = FontIdentifier(source.name);
+    font.c = options.trim ? options.c : 0;
+    font.default_code = (source.default_code >= 0 && glyphs.count(source.default_code)) ? source.default_code : ' ';
+
+    /*
+     * A block for every 256 code points with a glyph
+     */
+    font.block_index.assign((glyphs.rbegin()->first >> 8) + 1, WIDE_NO_BLOCK);
+    uint32_t index = 0;
+    for (const std::pair<const uint32_t, const SourceGlyph *> &entry : glyphs)
+    {
+        uint16_t &block = font.block_index[entry.first >> 8];
+        if (block == WIDE_NO_BLOCK)
+        {
+            block = font.blocks.size();
+            font.blocks.push_back(wide_char_block_t{index, {0}});
+        }
+        font.blocks[block].present[(entry.first & 0xFF) >> 5] |= 1u << (entry.first & 0x1F);
+        index++;
+    }
+    return true;
+} // ImportWideFont
+
+/**
+ * @brief Keeps the characters of a font a deployment uses
+ *
+ * The font's replacement for unknown characters, space or its first character,
+ * is always kept. Kept characters are numbered from 0 in code order, and the
+ * remap covers the codes from the first kept to the last. Characters sharing a
+ * bitmap in the font share it in the subset.
+ *
+ * @param font the font, compiled in or loaded
+ * @param used the character codes used
+ * @param subset the subset
+ * @param error why the font cannot be subset
+ * @return false if every character is kept, too many to remap, or the font has no bitmap
+ */
+bool SubsetFont(const font_info_t &font, const std::bitset<256> &used, FontSubset &subset, std::string &error)
+{
+    std::bitset<256> kept;
+    for (unsigned int c = font.char_start; c <= font.char_end; c++)
+    {
+        kept[c] = used[c];
+    }
+    unsigned char replacement = (' ' < font.char_start) ? font.char_start : ' ';
+    if (replacement <= font.char_end)
+        kept[replacement] = true;
+    if (kept.count() == (size_t)(font.char_end - font.char_start + 1))
+    {
+        error = std::string(font.name) + ": every character is used";
+        return false;
+    }
+    if (kept.count() >= SUBSET_NO_CHAR)
+    {
+        error = std::string(font.name) + ": too many characters are used to remap";
+        return false;
+    }
+    if (!font.bitmap)
+    {
+        error = std::string(font.name) + ": baked compressed, the bitmap is not linked";
+        return false;
+    }
+
+    subset = FontSubset();
+    subset.font.name = font.name;
+    subset.font.height = font.height;
+    subset.font.c = font.c;
+    subset.code_start = font.char_start;
+    while (!kept[subset.code_start])
+        subset.code_start++;
+    subset.code_end = font.char_end;
+    while (!kept[subset.code_end])
+        subset.code_end--;
+
+    std::map<uint16_t, uint16_t> offsets; // Font bitmap offset to subset offset
+    for (unsigned int c = subset.code_start; c <= subset.code_end; c++)
+    {
+        if (!kept[c])
+        {
+            subset.remap.push_back(SUBSET_NO_CHAR);
+            continue;
+        }
+        subset.remap.push_back(subset.font.descriptors.size());
+
+        font_char_desc_t char_desc = font.char_descriptors[c - font.char_start];
+        std::map<uint16_t, uint16_t>::iterator found = offsets.find(char_desc.offset);
+        if (found != offsets.end())
+        {
+            subset.font.descriptors.push_back({char_desc.width, found->second});
+            subset.font.glyphs_shared++;
+            continue;
+        }
+        size_t bytes = (size_t)font.height * (1 + ((char_desc.width - 1) / 8));
+        offsets[char_desc.offset] = subset.font.bitmap.size();
+        subset.font.descriptors.push_back({char_desc.width, (uint16_t)subset.font.bitmap.size()});
+        subset.font.bitmap.insert(subset.font.bitmap.end(), font.bitmap + char_desc.offset, font.bitmap + char_desc.offset + bytes);
+    }
+    subset.font.char_start = 0;
+    subset.font.char_end = subset.font.descriptors.size() - 1;
+    return true;
+} // SubsetFont
+
+/**
+ * @brief The flash a font's tables take, descriptors and bitmaps
+ *
+ * @param font the font
+ * @return the bytes
+ */
+size_t FontBytes(const font_info_t &font)
+{
+    return ((font.char_end - font.char_start + 1) * sizeof(font_char_desc_t)) + FontPack::BitmapBytes(&font);
+} // FontBytes
+
+/**
+ * @brief The flash a subset font's tables take, descriptors, bitmaps and remap
+ *
+ * @param font the font
+ * @return the bytes
+ */
+size_t FontBytes(const subset_font_info_t &font)
+{
+    return FontBytes(font.info) + (font.remap ? (font.code_end - font.code_start + 1) : 0);
+} // FontBytes
+
+/**
+ * @brief The C escape of a character for the header comments, U+ notation beyond a byte
+ */
+static std::string charComment(uint32_t c)
+{
+    char text[12];
+    if (c > 0xFF)
+        snprintf(text, sizeof(text), "U+%04X", c);
+    else if (c > ' ' && c < 0x7F && c != '\\' && c != '*' && c != '/')
+        snprintf(text, sizeof(text), "%c", c);
+    else
+        snprintf(text, sizeof(text), "\\x%02x", c);
+    return text;
+} // charComment
+
+/**
+ * @brief Writes the leading comment and include guard of a header
+ */
+static void writeHeading(std::ostream &out, const std::string &comment, const std::string &summary, const std::string &guard)
+{
+    out << "/**\n * This file contains generated binary font data.\n *\n";
+    std::istringstream lines(comment);
+    std::string text;
+    while (std::getline(lines, text))
+    {
+        out << (text.empty() ? " *" : " * " + text) << "\n";
+    }
+    out << " * " << summary << "\n */\n";
+    out << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+} // writeHeading
+
+/**
+ * @brief Writes each distinct character bitmap, in offset order, with its rows drawn
+ *
+ * @param out the header
+ * @param id the font identifier
+ * @param height the character height
+ * @param descriptors the descriptor of each character
+ * @param codes the character of each descriptor
+ * @param bitmap the character bitmaps
+ */
+static void writeBitmaps(std::ostream &out, const std::string &id, uint8_t height, const std::vector<wide_char_desc_t> &descriptors,
+                         const std::vector<uint32_t> &codes, const uint8_t *bitmap)
+{
+    char line[160];
+    std::set<uint32_t> written;
+    std::vector<size_t> order(descriptors.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return descriptors[a].offset < descriptors[b].offset; });
+
+    out << "static FONT_DATA uint8_t _fonts_" << id << "_bitmaps [] = {\n";
+    for (size_t i : order)
+    {
+        wide_char_desc_t char_desc = descriptors[i];
+        if (!written.insert(char_desc.offset).second)
+            continue;
+
+        uint8_t row_bytes = 1 + ((char_desc.width - 1) / 8);
+        snprintf(line, sizeof(line), "\n/* Index: 0x%02zx, char: %s, offset: 0x%04x */\n", i, charComment(codes[i]).c_str(), char_desc.offset);
+        out << line;
+        for (uint8_t row = 0; row < height; row++)
+        {
+            const uint8_t *bytes = bitmap + char_desc.offset + (row * row_bytes);
+            std::string art;
+            for (uint8_t b = 0; b < row_bytes; b++)
+            {
+                snprintf(line, sizeof(line), "0x%02x, ", bytes[b]);
+                out << line;
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    art += (bytes[b] & (0x80 >> bit)) ? '#' : '.';
+                }
+            }
+            out << "/* " << art << " */\n";
+        }
+    }
+    out << "};\n\n";
+} // writeBitmaps
+
+/**
+ * @brief Writes the bitmaps and descriptors of a font_info_t font
+ *
+ * @param out the header
+ * @param id the font identifier
+ * @param font the font
+ * @param codes the character of each descriptor
+ */
+static void writeTables(std::ostream &out, const std::string &id, const font_info_t &font, const std::vector<uint32_t> &codes)
+{
+    char line[160];
+    std::vector<wide_char_desc_t> descriptors;
+    for (size_t i = 0; i < codes.size(); i++)
+    {
+        descriptors.push_back({font.char_descriptors[i].offset, font.char_descriptors[i].width});
+    }
+    writeBitmaps(out, id, font.height, descriptors, codes, font.bitmap);
+
+    out << "FONT_DATA font_char_desc_t _fonts_" << id << "_descriptors [] = {\n";
+    for (size_t i = 0; i < codes.size(); i++)
+    {
+        snprintf(line, sizeof(line), "{ 0x%02x, 0x%04x }, /* Index: 0x%02zx, char: %s */\n", font.char_descriptors[i].width,
+                 font.char_descriptors[i].offset, i, charComment(codes[i]).c_str());
+        out << line;
+    }
+    out << "};\n\n";
+} // writeTables
+
+/**
+ * @brief Writes a font as a C header in the layout of the headers in main/fonts
+ *
+ * @param font the font
+ * @param comment lines describing the font and its licence, without comment markers
+ * @return the header source
+ */
+std::string FontHeader(const font_info_t &font, const std::string &comment)
+{
+    std::string id = FontIdentifier(font.name);
+    std::string guard = "_EXTRAS_FONTS_FONT_" + id + "_H_";
+    std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+    unsigned int count = font.char_end - font.char_start + 1;
+    std::ostringstream out;
+    char line[160];
+
+    snprintf(line, sizeof(line), "%u characters (%u..%u)", count, font.char_start, font.char_end);
+    writeHeading(out, comment, line, guard);
+
+    std::vector<uint32_t> codes;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        codes.push_back(font.char_start + i);
+    }
+    writeTables(out, id, font, codes);
+
+    out << "FONT_DATA font_info_t _fonts_" << id << "_info = {    //\n";
+    out << "        .name = \"" << id << "\",    //\n";
+    out << "                .height = " << (unsigned)font.height << ", /* Character height */\n";
+    out << "                .c = " << (unsigned)font.c << ", /* C */\n";
+    out << "                .char_start = " << (unsigned)font.char_start << ", /* Start character */\n";
+    out << "                .char_end = " << (unsigned)font.char_end << ", /* End character */\n";
+    out << "                .char_descriptors = _fonts_" << id << "_descriptors, /* Character descriptor array */\n";
+    out << "                .bitmap = _fonts_" << id << "_bitmaps, /* Character bitmap array */\n";
+    out << "        };\n\n";
+    out << "#endif /* " << guard << " */\n";
+    return out.str();
+} // FontHeader
+
+/**
+ * @brief Writes a wide font as a C header, its tables named as those of font_info_t headers
+ *
+ * @param font the font
+ * @param comment lines describing the font and its licence, without comment markers
+ * @return the header source
+ */
+std::string WideFontHeader(const wide_font_info_t &font, const std::string &comment)
+{
+    std::string id = FontIdentifier(font.info.name);
+    std::string guard = "_EXTRAS_FONTS_FONT_" + id + "_H_";
+    std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+    std::ostringstream out;
+    char line[160];
+
+    /*
+     * The code point of each descriptor, from the blocks
+     */
+    std::vector<uint32_t> codes;
+    for (uint32_t block = 0; block < font.block_count; block++)
+    {
+        if (font.block_index[block] == WIDE_NO_BLOCK)
+            continue;
+        for (uint32_t code = block << 8; code < (block + 1) << 8; code++)
+        {
+            if (font.blocks[font.block_index[block]].present[(code & 0xFF) >> 5] & (1u << (code & 0x1F)))
+                codes.push_back(code);
+        }
+    }
+    std::vector<wide_char_desc_t> descriptors(font.char_descriptors, font.char_descriptors + font.char_count);
+
+    snprintf(line, sizeof(line), "%u characters (%s..%s) in %zu blocks", font.char_count, charComment(codes.front()).c_str(),
+             charComment(codes.back()).c_str(), (size_t)std::count_if(font.block_index, font.block_index + font.block_count,
+                                                                      [](uint16_t block) { return block != WIDE_NO_BLOCK; }));
+    writeHeading(out, comment, line, guard);
+    writeBitmaps(out, id, font.info.height, descriptors, codes, font.info.bitmap);
+
+    out << "FONT_DATA wide_char_desc_t _fonts_" << id << "_descriptors [] = {\n";
+    for (size_t i = 0; i < descriptors.size(); i++)
+    {
+        snprintf(line, sizeof(line), "{ 0x%08x, 0x%02x }, /* Index: 0x%02zx, char: %s */\n", descriptors[i].offset, descriptors[i].width, i,
+                 charComment(codes[i]).c_str());
+        out << line;
+    }
+    out << "};\n\n";
+
+    out << "FONT_DATA wide_char_block_t _fonts_" << id << "_blocks [] = {\n";
+    for (uint32_t block = 0; block < font.block_count; block++)
+    {
+        if (font.block_index[block] == WIDE_NO_BLOCK)
+            continue;
+        const wide_char_block_t &entry = font.blocks[font.block_index[block]];
+        snprintf(line, sizeof(line), "{ 0x%04x, {", entry.first);
+        out << line;
+        for (int word = 0; word < 8; word++)
+        {
+            snprintf(line, sizeof(line), " 0x%08x%s", entry.present[word], (word < 7) ? "," : " } },");
+            out << line;
+        }
+        snprintf(line, sizeof(line), " /* U+%04X..U+%04X */\n", block << 8, (block << 8) | 0xFF);
+        out << line;
+    }
+    out << "};\n\n";
+
+    out << "FONT_DATA uint16_t _fonts_" << id << "_block_index [] = {\n";
+    for (uint32_t block = 0; block < font.block_count; block++)
+    {
+        snprintf(line, sizeof(line), "0x%04x,%s", font.block_index[block], ((block % 16) == 15 || block + 1 == font.block_count) ? "\n" : " ");
+        out << line;
+    }
+    out << "};\n\n";
+
+    out << "FONT_DATA wide_font_info_t _fonts_" << id << "_info = {    //\n";
+    out << "        .info = {    //\n";
+    out << "                .name = \"" << id << "\",    //\n";
+    out << "                .height = " << (unsigned)font.info.height << ", /* Character height */\n";
+    out << "                .c = " << (unsigned)font.info.c << ", /* C */\n";
+    out << "                .char_start = 0, /* Unused */\n";
+    out << "                .char_end = 0, /* Unused */\n";
+    out << "                .char_descriptors = 0, /* Unused */\n";
+    out << "                .bitmap = _fonts_" << id << "_bitmaps, /* Character bitmap array */\n";
+    out << "        },\n";
+    out << "        .default_code = " << font.default_code << ", /* Character for code points without one */\n";
+    out << "        .char_count = " << font.char_count << ", /* Number of characters */\n";
+    out << "        .block_count = " << font.block_count << ", /* Block index entries */\n";
+    out << "        .block_index = _fonts_" << id << "_block_index, /* Block of each 256 code points */\n";
+    out << "        .blocks = _fonts_" << id << "_blocks, /* Blocks with characters */\n";
+    out << "        .char_descriptors = _fonts_" << id << "_descriptors, /* Character descriptor array */\n";
+    out << "        };\n\n";
+    out << "#endif /* " << guard << " */\n";
+    return out.str();
+} // WideFontHeader
+
+/**
+ * @brief Writes a subset font as a C header, its tables named for the original font with _subset
+ *
+ * The font keeps the original name, and so its code page.
+ *
+ * @param font the font
+ * @param comment lines describing the font and its licence, without comment markers
+ * @return the header source
+ */
+std::string SubsetFontHeader(const subset_font_info_t &font, const std::string &comment)
+{
+    std::string id = FontIdentifier(font.info.name) + "_subset";
+    std::string guard = "_EXTRAS_FONTS_FONT_" + id + "_H_";
+    std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+    unsigned int count = font.info.char_end - font.info.char_start + 1;
+    unsigned int codes_remapped = font.code_end - font.code_start + 1;
+    std::ostringstream out;
+    char line[160];
+
+    std::vector<uint32_t> codes(count);
+    for (unsigned int i = 0; i < codes_remapped; i++)
+    {
+        if (font.remap[i] != SUBSET_NO_CHAR)
+            codes[font.remap[i]] = font.code_start + i;
+    }
+
+    snprintf(line, sizeof(line), "%u characters of %u..%u", count, font.code_start, font.code_end);
+    writeHeading(out, comment, line, guard);
+    writeTables(out, id, font.info, codes);
+
+    out << "FONT_DATA uint8_t _fonts_" << id << "_remap [] = {\n";
+    for (unsigned int i = 0; i < codes_remapped; i++)
+    {
+        snprintf(line, sizeof(line), "0x%02x,%s", font.remap[i], ((i % 16) == 15 || i + 1 == codes_remapped) ? "\n" : " ");
+        out << line;
+    }
+    out << "};\n\n";
+
+    out << "FONT_DATA subset_font_info_t _fonts_" << id << "_info = {    //\n";
+    out << "        .info = {    //\n";
+    out << "                .name = \"" << font.info.name << "\",    //\n";
+    out << "                .height = " << (unsigned)font.info.height << ", /* Character height */\n";
+    out << "                .c = " << (unsigned)font.info.c << ", /* C */\n";
+    out << "                .char_start = " << (unsigned)font.info.char_start << ", /* Start character */\n";
+    out << "                .char_end = " << (unsigned)font.info.char_end << ", /* End character */\n";
+    out << "                .char_descriptors = _fonts_" << id << "_descriptors, /* Character descriptor array */\n";
+    out << "                .bitmap = _fonts_" << id << "_bitmaps, /* Character bitmap array */\n";
+    out << "        },\n";
+    out << "        .code_start = " << (unsigned)font.code_start << ", /* First code remapped */\n";
+    out << "        .code_end = " << (unsigned)font.code_end << ", /* Last code remapped */\n";
+    out << "        .remap = _fonts_" << id << "_remap, /* Character of each code */\n";
+    out << "        };\n\n";
+    out << "#endif /* " << guard << " */\n";
+    return out.str();
+} // SubsetFontHeader
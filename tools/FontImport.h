@@ -0,0 +1,131 @@
+/*
+ Raster-Font Library Font Import
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#ifndef TOOLS_FONTIMPORT_H_
+#define TOOLS_FONTIMPORT_H_
+
+#include <stdint.h>
+#include <bitset>
+#include <string>
+#include <vector>
+
+#include "fonts.h"
+
+/**
+ * @brief A glyph as read from a bitmap font file
+ *
+ * Rows are MSB first, padded to whole bytes, top row first; the box is placed
+ * relative to the origin on the baseline, y up.
+ */
+struct SourceGlyph
+{
+    uint32_t code{0};           ///< Code point in the font's encoding
+    int advance{0};             ///< Pixels to the next glyph's origin
+    int width{0};               ///< Box width
+    int height{0};              ///< Box height
+    int x_offset{0};            ///< Box left from the origin
+    int y_offset{0};            ///< Box bottom from the baseline
+    std::vector<uint8_t> rows;  ///< The box rows
+
+    bool Pixel(int x, int y) const;
+};
+
+/**
+ * @brief The glyphs of a bitmap font file
+ */
+struct SourceFont
+{
+    std::string name;                 ///< Name from the file
+    int ascent{0};                    ///< Pixels above the baseline
+    int descent{0};                   ///< Pixels below the baseline
+    int64_t default_code{-1};         ///< Glyph for codes without one, -1 if not given
+    std::vector<SourceGlyph> glyphs;  ///< Glyphs in file order
+};
+
+/**
+ * @brief How a source font becomes a font_info_t font
+ */
+struct ImportOptions
+{
+    bool trim{false};   ///< Trim blank columns from each glyph, spacing them by c, and blank rows from the font
+    uint8_t c{1};       ///< Spacing between trimmed glyphs
+    bool dedup{true};   ///< Share the bitmap of identical glyphs
+};
+
+/**
+ * @brief A font in the font_info_t layout, owning its tables
+ */
+struct ImportedFont
+{
+    std::string name;                            ///< Font name, a C identifier
+    uint8_t height{0};                           ///< Character height
+    uint8_t c{0};                                ///< "C" spacing
+    unsigned char char_start{0};                 ///< First character
+    unsigned char char_end{0};                   ///< Last character
+    std::vector<font_char_desc_t> descriptors;   ///< Descriptor of each character
+    std::vector<uint8_t> bitmap;                 ///< Character bitmaps
+    size_t glyphs_shared{0};                     ///< Characters sharing another's bitmap
+
+    font_info_t Info() const;
+};
+
+/**
+ * @brief A wide font, characters by code point, owning its tables
+ */
+struct ImportedWideFont
+{
+    std::string name;                            ///< Font name, a C identifier
+    uint8_t height{0};                           ///< Character height
+    uint8_t c{0};                                ///< "C" spacing
+    uint32_t default_code{' '};                  ///< Character for code points without one
+    std::vector<uint16_t> block_index;           ///< Block of each 256 code points
+    std::vector<wide_char_block_t> blocks;       ///< The blocks with characters
+    std::vector<wide_char_desc_t> descriptors;   ///< Descriptor of each character, in code point order
+    std::vector<uint8_t> bitmap;                 ///< Character bitmaps
+    size_t glyphs_shared{0};                     ///< Characters sharing another's bitmap
+
+    wide_font_info_t Info() const;
+};
+
+/**
+ * @brief The characters kept from a font and the remap of its codes, owning its tables
+ */
+struct FontSubset
+{
+    ImportedFont font;                           ///< The kept characters, numbered from 0, named as the original
+    unsigned char code_start{0};                 ///< First code remapped
+    unsigned char code_end{0};                   ///< Last code remapped
+    std::vector<uint8_t> remap;                  ///< Kept character of each code from code_start, SUBSET_NO_CHAR if dropped
+
+    subset_font_info_t Info() const;
+};
+
+bool ReadBDF(const std::string &path, SourceFont &font, std::string &error);
+bool ReadPCF(const std::string &path, SourceFont &font, std::string &error);
+bool ReadFontFile(const std::string &path, SourceFont &font, std::string &error);
+bool ImportFont(const SourceFont &source, const ImportOptions &options, ImportedFont &font, std::string &error);
+bool ImportWideFont(const SourceFont &source, const ImportOptions &options, ImportedWideFont &font, std::string &error);
+bool SubsetFont(const font_info_t &font, const std::bitset<256> &used, FontSubset &subset, std::string &error);
+size_t FontBytes(const font_info_t &font);
+size_t FontBytes(const subset_font_info_t &font);
+std::string FontIdentifier(const std::string &text);
+std::string FontHeader(const font_info_t &font, const std::string &comment);
+std::string WideFontHeader(const wide_font_info_t &font, const std::string &comment);
+std::string SubsetFontHeader(const subset_font_info_t &font, const std::string &comment);
+
+#endif /* TOOLS_FONTIMPORT_H_ */
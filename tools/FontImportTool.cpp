@@ -0,0 +1,170 @@
+/*
+ Raster-Font Library Font Import Tool
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "FontImport.h"
+#include "FontPack.h"
+#include "WorkStealingPool.h"
+
+/*
+ * Usage: Raster-Font-import [--trim] [--c N] [--no-dedup] [--wide] [--out dir | --pack pack.rfp] font|dir ...
+ *
+ * Converts BDF and PCF fonts, and the .bdf and .pcf fonts of directories, in
+ * parallel, to font_info_t headers in the output directory, by default the
+ * current one, or to one font pack. --wide writes wide_font_info_t headers of
+ * every code point instead. A line per font reports its characters, bitmap
+ * bytes and characters sharing a bitmap.
+ */
+
+/**
+ * @brief A font to convert and its result
+ */
+struct Job
+{
+    std::string path;   ///< The font file
+    ImportedFont font;  ///< The converted font
+    ImportedWideFont wide; ///< The converted wide font
+    std::string error;  ///< Why it failed, empty if converted
+};
+
+/**
+ * @brief Is the file a font by its extension
+ */
+static bool fontFile(const std::filesystem::path &path)
+{
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension == ".bdf" || extension == ".pcf";
+} // fontFile
+
+int main(int argc, char *argv[])
+{
+    ImportOptions options;
+    std::string out_dir = ".", pack_path;
+    bool wide = false;
+    std::vector<Job> jobs;
+
+    for (int a = 1; a < argc; a++)
+    {
+        std::string arg = argv[a];
+        if (arg == "--trim")
+            options.trim = true;
+        else if (arg == "--no-dedup")
+            options.dedup = false;
+        else if (arg == "--wide")
+            wide = true;
+        else if (arg == "--c" && a + 1 < argc)
+            options.c = atoi(argv[++a]);
+        else if (arg == "--out" && a + 1 < argc)
+            out_dir = argv[++a];
+        else if (arg == "--pack" && a + 1 < argc)
+            pack_path = argv[++a];
+        else if (std::filesystem::is_directory(arg))
+        {
+            std::vector<std::string> found;
+            for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(arg))
+            {
+                if (entry.is_regular_file() && fontFile(entry.path()))
+                    found.push_back(entry.path().string());
+            }
+            std::sort(found.begin(), found.end());
+            for (const std::string &path : found)
+            {
+                jobs.push_back({path, {}, {}, {}});
+            }
+        }
+        else if (arg.compare(0, 2, "--"))
+            jobs.push_back({arg, {}, {}, {}});
+        else
+        {
+            jobs.clear(); // Unknown option
+            break;
+        }
+    }
+
+    if (jobs.empty() || (wide && !pack_path.empty()))
+    {
+        fprintf(stderr, "Usage: %s [--trim] [--c N] [--no-dedup] [--wide] [--out dir | --pack pack.rfp] font|dir ...\n", argv[0]);
+        if (wide && !pack_path.empty())
+            fprintf(stderr, "Font packs hold font_info_t fonts, not --wide fonts\n");
+        return 1;
+    }
+
+    WorkStealingPool pool;
+    pool.ParallelFor(jobs.size(), [&](size_t task, unsigned) {
+        Job &job = jobs[task];
+        SourceFont source;
+        if (!ReadFontFile(job.path, source, job.error))
+            return;
+        if (wide ? !ImportWideFont(source, options, job.wide, job.error) : !ImportFont(source, options, job.font, job.error))
+            return;
+        if (!pack_path.empty())
+            return;
+
+        std::string comment = "Imported from " + std::filesystem::path(job.path).filename().string();
+        std::string name = wide ? job.wide.name : job.font.name;
+        std::string header = wide ? WideFontHeader(job.wide.Info(), comment) : FontHeader(job.font.Info(), comment);
+        std::ofstream out(out_dir + "/" + name + ".h", std::ios::binary);
+        if (!(out << header))
+            job.error = "cannot write " + out_dir + "/" + name + ".h";
+    });
+
+    int status = 0;
+    std::vector<font_info_t> infos;
+    for (const Job &job : jobs)
+    {
+        if (!job.error.empty())
+        {
+            fprintf(stderr, "%s\n", job.error.c_str());
+            status = 1;
+            continue;
+        }
+        if (wide)
+        {
+            printf("%s,%s,%zu,%zu,%zu\n", job.path.c_str(), job.wide.name.c_str(), job.wide.descriptors.size(), job.wide.bitmap.size(),
+                   job.wide.glyphs_shared);
+            continue;
+        }
+        printf("%s,%s,%u,%zu,%zu\n", job.path.c_str(), job.font.name.c_str(), job.font.char_end - job.font.char_start + 1,
+               job.font.bitmap.size(), job.font.glyphs_shared);
+        infos.push_back(job.font.Info());
+    }
+
+    if (!pack_path.empty() && !infos.empty())
+    {
+        std::vector<const font_info_t *> selected;
+        for (const font_info_t &info : infos)
+        {
+            selected.push_back(&info);
+        }
+        if (!FontPack::Write(pack_path.c_str(), selected.data(), selected.size()))
+        {
+            fprintf(stderr, "Cannot write font pack %s\n", pack_path.c_str());
+            return 1;
+        }
+    }
+    return status;
+} // main
@@ -0,0 +1,98 @@
+/*
+ Raster-Font Library Font Pack Tool
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "FontManager.h"
+#include "FontPack.h"
+
+/*
+ * Usage: Raster-Font-pack pack.rfp [font name ...]
+ *        Raster-Font-pack --list pack.rfp
+ *
+ * Writes the compiled in fonts named, or all of them, to a font pack, or lists
+ * the fonts of a pack, subset fonts by the codes they remap and the characters
+ * they keep.
+ */
+
+/**
+ * @brief Lists the fonts of a pack
+ */
+static int list(const char *path)
+{
+    FontPack pack;
+    if (!pack.Open(path))
+    {
+        fprintf(stderr, "Cannot open font pack %s\n", path);
+        return 1;
+    }
+
+    for (uint16_t i = 0; i < pack.FontCount(); i++)
+    {
+        const subset_font_info_t *font = pack.Subset(i);
+        if (!font)
+        {
+            fprintf(stderr, "Font %u of %s is malformed\n", i, path);
+            return 1;
+        }
+        if (font->remap)
+            printf("%u,%s,%u,%u,%u,%u,subset of %u\n", i, font->info.name, font->info.height, font->info.c, font->code_start,
+                   font->code_end, font->info.char_end - font->info.char_start + 1);
+        else
+            printf("%u,%s,%u,%u,%u,%u\n", i, font->info.name, font->info.height, font->info.c, font->info.char_start,
+                   font->info.char_end);
+    }
+    return pack.Verify() ? 0 : 1;
+} // list
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s pack.rfp [font name ...] | --list pack.rfp\n", argv[0]);
+        return 1;
+    }
+    if (!strcmp(argv[1], "--list"))
+        return (argc == 3) ? list(argv[2]) : 1;
+
+    std::vector<const font_info_t *> selected;
+    for (uint8_t i = 0; i < FontManager::FontCount(); i++)
+    {
+        bool wanted = (argc == 2);
+        for (int a = 2; a < argc; a++)
+        {
+            wanted = wanted || !strcmp(argv[a], fonts[i]->name);
+        }
+        if (wanted)
+            selected.push_back(fonts[i]);
+    }
+    if (selected.size() < (size_t)((argc == 2) ? 1 : argc - 2))
+    {
+        fprintf(stderr, "Unknown font name\n");
+        return 1;
+    }
+
+    if (!FontPack::Write(argv[1], selected.data(), selected.size()))
+    {
+        fprintf(stderr, "Cannot write font pack %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+} // main
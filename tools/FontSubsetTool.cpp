@@ -0,0 +1,184 @@
+/*
+ Raster-Font Library Font Subset Tool
+
+ v0.1.0
+
+ Copyright 2019 technosf [https://github.com/technosf]
+
+ Licensed under the GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0 or greater (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ https://www.gnu.org/licenses/lgpl-3.0.en.html
+ Unless required by applicable law or agreed to in writing,
+ software distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <bitset>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "CodePage.h"
+#include "FontImport.h"
+#include "FontManager.h"
+#include "FontPack.h"
+
+/*
+ * Usage: Raster-Font-subset [--utf8] [--text string] [--corpus file] [--out dir | --pack pack.rfp] [font name ...]
+ *
+ * Keeps only the characters of the compiled in fonts named, or all of them,
+ * that the corpus uses: the strings given by --text and each line of the
+ * --corpus files, as font bytes or, with --utf8, as UTF-8 mapped to each
+ * font's code page. Writes a subset font header per font to the output
+ * directory, by default the current one, or all to one font pack. A line per
+ * font reports its characters kept, its flash before and after, and the flash
+ * saved, with a total line last.
+ */
+
+int main(int argc, char *argv[])
+{
+    bool utf8 = false, usage = false;
+    std::string out_dir = ".", pack_path;
+    std::vector<std::string> corpus, names;
+
+    for (int a = 1; a < argc; a++)
+    {
+        std::string arg = argv[a];
+        if (arg == "--utf8")
+            utf8 = true;
+        else if (arg == "--text" && a + 1 < argc)
+            corpus.push_back(argv[++a]);
+        else if (arg == "--corpus" && a + 1 < argc)
+        {
+            std::ifstream in(argv[++a], std::ios::binary);
+            if (!in)
+            {
+                fprintf(stderr, "Cannot read corpus %s\n", argv[a]);
+                return 1;
+            }
+            for (std::string line; std::getline(in, line);)
+            {
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                corpus.push_back(line);
+            }
+        }
+        else if (arg == "--out" && a + 1 < argc)
+            out_dir = argv[++a];
+        else if (arg == "--pack" && a + 1 < argc)
+            pack_path = argv[++a];
+        else if (arg.compare(0, 2, "--"))
+            names.push_back(arg);
+        else
+            usage = true; // Unknown option
+    }
+
+    if (usage || corpus.empty())
+    {
+        fprintf(stderr, "Usage: %s [--utf8] [--text string] [--corpus file] [--out dir | --pack pack.rfp] [font name ...]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<const font_info_t *> selected;
+    for (uint8_t i = 0; i < FontManager::FontCount(); i++)
+    {
+        bool wanted = names.empty();
+        for (const std::string &name : names)
+        {
+            wanted = wanted || name == fonts[i]->name;
+        }
+        if (wanted)
+            selected.push_back(fonts[i]);
+    }
+    if (selected.size() < names.size())
+    {
+        fprintf(stderr, "Unknown font name\n");
+        return 1;
+    }
+
+    int status = 0;
+    long long total_before = 0, total_after = 0;
+    std::vector<FontSubset> subsets(selected.size());
+    std::vector<subset_font_info_t> infos;
+    for (size_t i = 0; i < selected.size(); i++)
+    {
+        const font_info_t *font = selected[i];
+        unsigned char replacement = (' ' < font->char_start) ? font->char_start : ' ';
+        std::bitset<256> used;
+        std::string bytes;
+        for (const std::string &text : corpus)
+        {
+            std::string_view font_text = text;
+            if (utf8)
+                font_text = TranscodeUtf8(text, CodePageOf(font->name), font->char_start, font->char_end, replacement, bytes);
+            for (unsigned char c : font_text)
+            {
+                used[c] = true;
+            }
+        }
+
+        bool dropped = false;
+        for (unsigned int c = font->char_start; c <= font->char_end; c++)
+        {
+            dropped = dropped || (!used[c] && c != replacement);
+        }
+        if (!dropped)
+        /*
+         * Nothing to save, the remap only adding to the whole font
+         */
+        {
+            fprintf(stderr, "%s: every character is used, skipped\n", font->name);
+            continue;
+        }
+
+        std::string error;
+        if (!SubsetFont(*font, used, subsets[i], error))
+        {
+            fprintf(stderr, "%s\n", error.c_str());
+            status = 1;
+            continue;
+        }
+        subset_font_info_t info = subsets[i].Info();
+        long long before = FontBytes(*font), after = FontBytes(info);
+        if (after >= before)
+        {
+            fprintf(stderr, "%s: the subset is no smaller, %lld bytes for %lld, skipped\n", font->name, after, before);
+            continue;
+        }
+        total_before += before;
+        total_after += after;
+        printf("%s,%u,%lld,%lld,%lld\n", font->name, info.info.char_end + 1, before, after, before - after);
+        infos.push_back(info);
+
+        if (!pack_path.empty())
+            continue;
+        std::string path = out_dir + "/" + FontIdentifier(font->name) + "_subset.h";
+        std::ofstream out(path, std::ios::binary);
+        if (!(out << SubsetFontHeader(info, std::string("Subset of ") + font->name)))
+        {
+            fprintf(stderr, "Cannot write %s\n", path.c_str());
+            status = 1;
+        }
+    }
+    printf("total,,%lld,%lld,%lld\n", total_before, total_after, total_before - total_after);
+
+    if (!pack_path.empty() && !infos.empty())
+    {
+        std::vector<const subset_font_info_t *> packed;
+        for (const subset_font_info_t &info : infos)
+        {
+            packed.push_back(&info);
+        }
+        if (!FontPack::Write(pack_path.c_str(), packed.data(), packed.size()))
+        {
+            fprintf(stderr, "Cannot write font pack %s\n", pack_path.c_str());
+            return 1;
+        }
+    }
+    return status;
+} // main